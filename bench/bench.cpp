@@ -0,0 +1,266 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#include "engine.hpp"
+#include "logger.hpp"
+#include "renderer.hpp"
+#include "scene.hpp"
+#include "util.hpp"
+
+#include <json.hpp>
+
+extern bool use_hz;
+
+extern bool use_deferred;
+
+extern std::string ibl_cache_dir;
+
+struct BenchArgs{
+    std::string scene_dir = "../scenes";
+    std::string output_file;
+    int warmup_frames = 3;
+    int measured_frames = 10;
+    // empty by default so every run measures the cold IBL precompute
+    std::string ibl_cache_dir;
+};
+
+BenchArgs bench_args;
+
+void SetArgv(int argc, char** argv){
+    for(int i = 0; i < argc; ++i){
+        auto arg = std::string(argv[i]);
+        if(arg == "-scenes" && i + 1 < argc){
+            bench_args.scene_dir = argv[++i];
+        }
+        else if(arg == "-o" && i + 1 < argc){
+            bench_args.output_file = argv[++i];
+        }
+        else if(arg == "-warmup" && i + 1 < argc){
+            bench_args.warmup_frames = std::stoi(argv[++i]);
+        }
+        else if(arg == "-frames" && i + 1 < argc){
+            bench_args.measured_frames = std::max(1, std::stoi(argv[++i]));
+        }
+        else if(arg == "-ibl-cache" && i + 1 < argc){
+            bench_args.ibl_cache_dir = argv[++i];
+        }
+        else if(arg == "-hz"){
+            use_hz = true;
+        }
+        else if(arg == "-deferred"){
+            use_deferred = true;
+        }
+        else if(arg == "-debug"){
+            SET_LOG_LEVEL_DEBUG
+        }
+        else if(arg == "-info"){
+            SET_LOG_LEVEL_INFO
+        }
+        else{
+            std::cerr<<"params format: [-scenes dir], [-o result.json], [-warmup n], [-frames n], [-hz], [-deferred], "
+                       "[-ibl-cache dir], [-debug] or [-info]"<<std::endl;
+        }
+    }
+}
+
+// scene files are sorted so results of different runs line up
+static std::vector<std::filesystem::path> FindScenes(const std::string &scene_dir)
+{
+    std::vector<std::filesystem::path> scenes;
+    for (auto &entry : std::filesystem::recursive_directory_iterator(scene_dir))
+    {
+        auto name = entry.path().filename().string();
+        const std::string suffix = "_scene.json";
+        if (entry.is_regular_file() && name.size() > suffix.size() &&
+            name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0)
+        {
+            scenes.emplace_back(entry.path());
+        }
+    }
+    std::sort(scenes.begin(), scenes.end());
+    return scenes;
+}
+
+// use xxx_camera_path.json next to xxx_scene.json if exists,
+// otherwise orbit default camera around origin in four fixed poses
+static std::vector<Camera> BenchCameras(const std::filesystem::path &scene_file)
+{
+    auto name = scene_file.filename().string();
+    auto camera_path = scene_file.parent_path() / (name.substr(0, name.size() - 11) + "_camera_path.json");
+    if (std::filesystem::exists(camera_path))
+    {
+        return LoadCameraPath(camera_path.string());
+    }
+    std::vector<Camera> cameras;
+    for (int i = 0; i < 4; i++)
+    {
+        Camera camera;
+        float theta = glm::radians(90.f * i);
+        float radius = length(camera.position - camera.target);
+        camera.position = camera.target + float3{radius * std::sin(theta), 0.f, radius * std::cos(theta)};
+        camera.front = normalize(camera.target - camera.position);
+        camera.right = normalize(cross(camera.front, camera.world_up));
+        camera.up = normalize(cross(camera.right, camera.front));
+        cameras.emplace_back(camera);
+    }
+    return cameras;
+}
+
+// nearest rank percentile
+static double Percentile(const std::vector<double> &sorted, double p)
+{
+    if (sorted.empty())
+        return 0.0;
+    int rank = static_cast<int>(std::ceil(p / 100.0 * sorted.size()));
+    return sorted[std::clamp(rank - 1, 0, static_cast<int>(sorted.size()) - 1)];
+}
+
+static nlohmann::json Summarize(std::vector<double> samples)
+{
+    std::sort(samples.begin(), samples.end());
+    double sum = 0.0;
+    for (auto t : samples)
+        sum += t;
+    nlohmann::json j;
+    j["min"]  = samples.front();
+    j["mean"] = sum / samples.size();
+    j["p50"]  = Percentile(samples, 50.0);
+    j["p90"]  = Percentile(samples, 90.0);
+    j["p99"]  = Percentile(samples, 99.0);
+    j["max"]  = samples.back();
+    return j;
+}
+
+static nlohmann::json BenchScene(Engine &engine, const std::filesystem::path &scene_file)
+{
+    auto &scene = *engine.getScene();
+    auto &renderer = engine.getRenderer();
+
+    scene.clearScene();
+    scene.clearSkyBox();
+    LoadProgress load_progress;
+    Timer load_timer;
+    load_timer.start();
+    scene.loadScene(scene_file.string(), &load_progress);
+    load_timer.stop();
+    auto cameras = BenchCameras(scene_file);
+
+    // present copies framebuffer into a staging buffer like what displayer uploads to sdl texture
+    const auto &image = renderer.getImage();
+    std::vector<uint8_t> staging(static_cast<size_t>(image.pitch()) * image.height());
+
+    const std::array<const char *, 8> stage_names = {"clear", "cull", "vertex",  "raster",
+                                                     "shade", "sky",  "present", "frame"};
+    std::array<std::vector<double>, 8> samples;
+
+    for (auto &camera : cameras)
+    {
+        scene.setCamera(camera);
+        for (int i = 0; i < bench_args.warmup_frames + bench_args.measured_frames; i++)
+        {
+            renderer.resetStats();
+
+            Timer frame_timer;
+            frame_timer.start();
+            engine.renderFrame();
+
+            Timer present_timer;
+            present_timer.start();
+            std::memcpy(staging.data(), renderer.getImage().data(), staging.size());
+            present_timer.stop();
+            frame_timer.stop();
+
+            if (i < bench_args.warmup_frames)
+                continue;
+
+            const auto &stats = renderer.getStats();
+            samples[0].emplace_back(stats.clear);
+            samples[1].emplace_back(stats.cull);
+            samples[2].emplace_back(stats.vertex);
+            samples[3].emplace_back(stats.raster);
+            samples[4].emplace_back(stats.shade);
+            samples[5].emplace_back(stats.sky);
+            samples[6].emplace_back(present_timer.duration().ms().count());
+            samples[7].emplace_back(frame_timer.duration().ms().count());
+        }
+    }
+
+    nlohmann::json result;
+    result["scene"] = scene_file.generic_string();
+    result["camera_count"] = cameras.size();
+    result["model_count"] = scene.getModels().size();
+    // one shot costs of the scene, load includes ibl
+    result["load_ms"] = load_timer.duration().ms().count();
+    result["ibl_ms"] = load_progress.ibl_ms;
+    for (size_t i = 0; i < stage_names.size(); i++)
+    {
+        result["stages_ms"][stage_names[i]] = Summarize(std::move(samples[i]));
+    }
+    return result;
+}
+
+int main(int argc, char **argv)
+{
+    SET_LOG_LEVEL_CRITICAL
+    if(argc > 1){
+        SetArgv(argc - 1,argv + 1);
+    }
+    ibl_cache_dir = bench_args.ibl_cache_dir;
+
+    nlohmann::json report;
+    report["width"] = ScreenWidth;
+    report["height"] = ScreenHeight;
+    report["warmup_frames"] = bench_args.warmup_frames;
+    report["measured_frames"] = bench_args.measured_frames;
+    report["hierarchical_zbuffer"] = use_hz;
+    report["deferred"] = use_deferred;
+    report["ibl_cache"] = !bench_args.ibl_cache_dir.empty();
+#ifdef USE_OMP
+    report["parallel"] = "openmp";
+#else
+    report["parallel"] = "task_scheduler";
+#endif
+    report["scenes"] = nlohmann::json::array();
+
+    try
+    {
+        auto &engine = Engine::getInstance();
+        engine.startup(true);
+
+        for (auto &scene_file : FindScenes(bench_args.scene_dir))
+        {
+            // a broken scene should not stop the whole benchmark
+            try
+            {
+                report["scenes"].emplace_back(BenchScene(engine, scene_file));
+            }
+            catch (const std::exception &err)
+            {
+                report["scenes"].push_back({{"scene", scene_file.generic_string()}, {"error", err.what()}});
+            }
+        }
+
+        engine.shutdown();
+    }
+    catch (const std::exception &err)
+    {
+        std::cerr << err.what() << std::endl;
+        return 1;
+    }
+
+    if (bench_args.output_file.empty())
+    {
+        std::cout << report.dump(2) << std::endl;
+    }
+    else
+    {
+        std::ofstream out(bench_args.output_file);
+        out << report.dump(2) << std::endl;
+    }
+    return 0;
+}
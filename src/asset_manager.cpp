@@ -0,0 +1,28 @@
+#include <filesystem>
+
+#include "asset_manager.hpp"
+
+AssetManager &AssetManager::getInstance()
+{
+    static AssetManager asset_manager;
+    return asset_manager;
+}
+
+void AssetManager::purge()
+{
+    std::lock_guard<std::mutex> lk(mut);
+    for (auto it = assets.begin(); it != assets.end();)
+    {
+        if (it->second.asset.expired() && !it->second.loading.valid())
+            it = assets.erase(it);
+        else
+            ++it;
+    }
+}
+
+std::string AssetManager::canonicalPath(const std::string &path)
+{
+    std::error_code ec;
+    auto canonical = std::filesystem::weakly_canonical(path, ec);
+    return ec ? path : canonical.generic_string();
+}
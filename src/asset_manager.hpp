@@ -0,0 +1,98 @@
+#pragma once
+
+#include <future>
+#include <map>
+#include <mutex>
+#include <string>
+#include <typeindex>
+
+#include "common.hpp"
+#include "logger.hpp"
+
+/**
+ * @brief hand out shared immutable assets keyed by asset type and canonical file path,
+ * so models referring to the same file share one load and one allocation.
+ * Concurrent requests of an asset still being loaded wait for that load instead of repeating it.
+ * Only weak references are kept, an asset is freed once no model uses it.
+ */
+class AssetManager
+{
+  public:
+    static AssetManager &getInstance();
+
+    // return cached asset of type T for path or create it by loader() which returns T
+    template <typename T, typename Loader>
+    RC<const T> load(const std::string &path, Loader &&loader);
+
+    // forget expired entries
+    void purge();
+
+  private:
+    AssetManager() = default;
+
+    static std::string canonicalPath(const std::string &path);
+
+    using Key = std::pair<std::type_index, std::string>;
+
+    struct Entry
+    {
+        std::weak_ptr<const void> asset;
+        // valid while the asset is being loaded
+        std::shared_future<RC<const void>> loading;
+    };
+
+    std::mutex mut;
+    std::map<Key, Entry> assets;
+};
+
+template <typename T, typename Loader>
+RC<const T> AssetManager::load(const std::string &path, Loader &&loader)
+{
+    Key key{std::type_index(typeid(T)), canonicalPath(path)};
+    std::promise<RC<const void>> promise;
+    std::shared_future<RC<const void>> loading;
+    {
+        std::lock_guard<std::mutex> lk(mut);
+        auto &entry = assets[key];
+        if (auto asset = entry.asset.lock())
+        {
+            LOG_DEBUG("reuse loaded asset: {}", path);
+            return std::static_pointer_cast<const T>(asset);
+        }
+        if (entry.loading.valid())
+            loading = entry.loading;
+        else
+            entry.loading = promise.get_future().share();
+    }
+    if (loading.valid())
+    {
+        LOG_DEBUG("wait for loading asset: {}", path);
+        // rethrow the exception of the first load if it failed
+        return std::static_pointer_cast<const T>(loading.get());
+    }
+
+    // load without lock so different assets can be loaded concurrently
+    RC<const T> asset;
+    try
+    {
+        asset = std::make_shared<const T>(loader());
+    }
+    catch (...)
+    {
+        {
+            std::lock_guard<std::mutex> lk(mut);
+            assets[key].loading = {};
+        }
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+
+    {
+        std::lock_guard<std::mutex> lk(mut);
+        auto &entry = assets[key];
+        entry.asset = asset;
+        entry.loading = {};
+    }
+    promise.set_value(asset);
+    return asset;
+}
@@ -0,0 +1,520 @@
+// generated by BRDFLUTGenerator, do not edit
+// 64x64 brdf lut of 1024 samples per texel, rows of roughness with (scale, bias) of F0 as 16 bit unorm
+#include <cstdint>
+
+#include "model.hpp"
+
+extern const uint16_t BRDFLUTData[IBL::BRDFLUTSize * IBL::BRDFLUTSize * 2] = {
+    33,65503, 5039,60496, 9763,55772, 14187,51348, 18326,47210, 22193,43342, 25802,39733, 29168,36367,
+    32301,33234, 35214,30321, 37920,27615, 40429,25106, 42751,22784, 44899,20636, 46882,18653, 48709,16826,
+    50391,15145, 51935,13601, 53350,12185, 54644,10890, 55827,9708, 56904,8630, 57884,7650, 58772,6762,
+    59578,5958, 60303,5232, 60955,4579, 61543,3993, 62067,3468, 62535,3000, 62951,2584, 63319,2216,
+    63644,1890, 63931,1605, 64180,1354, 64399,1136, 64587,948, 64751,785, 64891,645, 65010,526,
+    65110,425, 65195,340, 65266,270, 65323,211, 65371,164, 65411,125, 65442,94, 65466,69,
+    65484,50, 65499,36, 65511,25, 65519,16, 65524,11, 65528,7, 65531,4, 65532,2,
+    65534,1, 65535,1, 65535,0, 65535,0, 65535,0, 65535,0, 65535,0, 65535,0,
+    220,41462, 4967,59565, 9691,55348, 14118,51092, 18260,47035, 22130,43216, 25743,39638, 29110,36294,
+    32246,33177, 35162,30275, 37870,27578, 40381,25077, 42707,22759, 44856,20616, 46841,18636, 48671,16812,
+    50354,15133, 51900,13591, 53317,12177, 54613,10884, 55798,9702, 56877,8626, 57858,7647, 58748,6759,
+    59553,5955, 60280,5230, 60935,4577, 61522,3991, 62048,3467, 62516,2999, 62934,2584, 63303,2215,
+    63629,1890, 63916,1604, 64167,1354, 64386,1136, 64575,947, 64739,784, 64879,645, 64999,526,
+    65100,425, 65186,340, 65258,270, 65316,211, 65364,163, 65404,125, 65435,94, 65460,69,
+    65480,50, 65495,36, 65507,25, 65515,16, 65521,11, 65526,7, 65528,4, 65531,2,
+    65532,1, 65532,1, 65534,0, 65534,0, 65535,0, 65535,0, 65535,0, 65535,0,
+    1123,48545, 4807,56765, 9505,54060, 13929,50312, 18074,46507, 21950,42834, 25569,39350, 28944,36072,
+    32086,33002, 35009,30136, 37724,27466, 40242,24986, 42574,22685, 44730,20555, 46721,18586, 48556,16771,
+    50245,15099, 51796,13563, 53218,12154, 54520,10864, 55709,9686, 56793,8612, 57778,7636, 58672,6750,
+    59481,5948, 60212,5224, 60870,4572, 61461,3987, 61990,3464, 62462,2997, 62882,2581, 63255,2213,
+    63583,1889, 63873,1603, 64126,1353, 64348,1136, 64540,947, 64705,784, 64848,644, 64970,526,
+    65073,425, 65160,340, 65233,270, 65294,211, 65344,163, 65384,125, 65417,94, 65444,69,
+    65465,50, 65481,36, 65494,25, 65503,16, 65511,11, 65516,7, 65520,4, 65524,2,
+    65526,1, 65528,1, 65529,0, 65531,0, 65532,0, 65533,0, 65534,0, 65535,0,
+    2587,49145, 4698,52351, 9274,51889, 13667,49008, 17801,45602, 21673,42165, 25294,38837, 28680,35691,
+    31832,32703, 34764,29898, 37488,27275, 40016,24831, 42357,22558, 44523,20451, 46523,18501, 48367,16701,
+    50065,15042, 51625,13515, 53055,12115, 54365,10832, 55561,9660, 56652,8591, 57645,7618, 58546,6735,
+    59362,5936, 60099,5214, 60763,4565, 61359,3981, 61894,3459, 62371,2993, 62796,2578, 63174,2211,
+    63507,1887, 63801,1602, 64059,1352, 64284,1135, 64480,946, 64649,784, 64795,644, 64920,525,
+    65027,425, 65117,340, 65193,270, 65256,211, 65309,163, 65352,125, 65388,94, 65417,69,
+    65440,50, 65458,36, 65473,25, 65485,16, 65494,11, 65501,7, 65507,4, 65512,2,
+    65516,1, 65520,1, 65523,0, 65525,0, 65528,0, 65531,0, 65533,0, 65535,0,
+    4465,48320, 4802,46987, 9092,48938, 13388,47118, 17477,44277, 21342,41240, 24961,38147, 28342,35135,
+    31496,32258, 34433,29537, 37164,26980, 39699,24588, 42060,22373, 44238,20301, 46250,18379, 48106,16601,
+    49815,14959, 51386,13448, 52828,12060, 54148,10787, 55355,9623, 56456,8561, 57458,7594, 58369,6716,
+    59194,5920, 59939,5202, 60612,4555, 61216,3973, 61758,3453, 62243,2988, 62675,2575, 63059,2208,
+    63399,1885, 63699,1600, 63963,1351, 64194,1134, 64395,946, 64570,784, 64721,644, 64851,525,
+    64962,425, 65056,340, 65136,270, 65204,211, 65260,164, 65307,125, 65346,94, 65378,69,
+    65404,50, 65426,36, 65444,25, 65458,17, 65470,11, 65480,7, 65489,4, 65496,2,
+    65502,1, 65508,1, 65513,0, 65518,0, 65523,0, 65527,0, 65531,0, 65535,0,
+    6551,46724, 5235,41792, 9045,45333, 13153,44682, 17163,42594, 20978,39968, 24564,37151, 27939,34373,
+    31106,31691, 34050,29089, 36789,26620, 39334,24296, 41695,22120, 43881,20090, 45903,18202, 47769,16453,
+    49488,14836, 51069,13345, 52534,11983, 53870,10727, 55091,9575, 56204,8522, 57219,7563, 58141,6691,
+    58977,5901, 59734,5187, 60417,4543, 61031,3964, 61583,3446, 62078,2983, 62519,2571, 62911,2206,
+    63260,1884, 63568,1600, 63839,1351, 64077,1134, 64286,946, 64467,784, 64624,645, 64760,526,
+    64877,426, 64978,341, 65063,270, 65136,212, 65197,164, 65249,125, 65292,94, 65328,70,
+    65359,51, 65384,36, 65406,25, 65424,17, 65440,11, 65453,7, 65465,4, 65475,2,
+    65484,1, 65493,1, 65501,0, 65508,0, 65516,0, 65522,0, 65529,0, 65535,0,
+    8730,44851, 6044,37638, 9215,41518, 13034,41869, 16892,40514, 20628,38422, 24172,35970, 27523,33453,
+    30654,30908, 33592,28463, 36333,26117, 38899,23914, 41275,21816, 43474,19844, 45509,18002, 47389,16290,
+    49122,14702, 50718,13236, 52185,11884, 53530,10642, 54761,9504, 55886,8463, 56912,7514, 57845,6651,
+    58693,5868, 59470,5164, 60174,4529, 60803,3954, 61367,3439, 61873,2979, 62326,2569, 62729,2205,
+    63088,1883, 63406,1600, 63686,1352, 63934,1136, 64151,948, 64340,786, 64506,647, 64649,528,
+    64774,427, 64881,343, 64973,272, 65052,213, 65119,165, 65177,126, 65226,95, 65267,70,
+    65303,51, 65333,36, 65360,25, 65382,17, 65402,11, 65419,7, 65435,4, 65449,2,
+    65462,1, 65474,1, 65486,0, 65496,0, 65507,0, 65517,0, 65526,0, 65535,0,
+    10919,42901, 7195,34608, 9644,37830, 13080,38855, 16718,38148, 20313,36540, 23786,34530, 27095,32330,
+    30199,30012, 33128,27753, 35858,25532, 38399,23397, 40776,21392, 42980,19494, 45029,17720, 46940,16080,
+    48693,14536, 50306,13102, 51789,11777, 53151,10556, 54398,9435, 55539,8408, 56581,7470, 57530,6617,
+    58392,5841, 59174,5139, 59882,4506, 60521,3936, 61096,3424, 61613,2967, 62076,2559, 62490,2197,
+    62858,1878, 63201,1600, 63500,1354, 63760,1139, 63988,951, 64188,789, 64363,650, 64516,531,
+    64649,430, 64765,345, 64865,274, 64951,215, 65026,167, 65091,128, 65146,96, 65194,72,
+    65236,52, 65272,37, 65304,26, 65332,17, 65357,11, 65379,7, 65400,4, 65418,2,
+    65436,1, 65452,1, 65468,0, 65482,0, 65496,0, 65510,0, 65523,0, 65534,0,
+    13083,40925, 8623,32414, 10351,34584, 13328,35820, 16686,35650, 20103,34524, 23454,32890, 26673,30977,
+    29737,28945, 32638,26891, 35350,24828, 37887,22829, 40271,20936, 42475,19114, 44518,17394, 46415,15787,
+    48181,14297, 49802,12903, 51304,11617, 52699,10439, 53974,9348, 55135,8341, 56196,7419, 57162,6577,
+    58042,5812, 58842,5118, 59566,4490, 60221,3925, 60812,3417, 61344,2963, 61821,2558, 62249,2198,
+    62631,1880, 62972,1599, 63274,1352, 63543,1137, 63780,950, 63989,789, 64173,650, 64334,531,
+    64475,430, 64616,348, 64733,278, 64831,219, 64915,170, 64989,131, 65053,99, 65108,73,
+    65157,54, 65201,38, 65239,27, 65273,18, 65304,12, 65332,8, 65358,5, 65382,3,
+    65405,1, 65426,1, 65446,0, 65465,0, 65483,0, 65501,0, 65518,0, 65533,0,
+    15227,38947, 10267,30737, 11320,31869, 13802,32948, 16821,33080, 20012,32374, 23205,31101, 26315,29499,
+    29294,27703, 32139,25861, 34820,23988, 37354,22163, 39723,20380, 41919,18649, 43973,17020, 45894,15496,
+    47660,14049, 49289,12696, 50791,11438, 52182,10280, 53469,9216, 54642,8232, 55713,7328, 56706,6509,
+    57626,5769, 58453,5090, 59199,4472, 59874,3914, 60483,3411, 61033,2961, 61528,2559, 61972,2201,
+    62369,1884, 62725,1604, 63042,1358, 63324,1143, 63575,957, 63797,795, 63993,656, 64166,536,
+    64318,435, 64452,350, 64570,279, 64674,219, 64765,171, 64845,131, 64915,99, 64978,74,
+    65038,54, 65110,40, 65160,28, 65203,19, 65241,13, 65277,8, 65309,5, 65339,3,
+    65368,2, 65395,1, 65420,0, 65445,0, 65468,0, 65490,0, 65512,0, 65531,0,
+    17353,36966, 12075,29356, 12516,29580, 14506,30366, 17150,30598, 20069,30169, 23065,29212, 26042,27925,
+    28917,26377, 31687,24747, 34307,23039, 36801,21366, 39135,19701, 41344,18119, 43405,16594, 45314,15130,
+    47079,13741, 48724,12449, 50260,11253, 51667,10131, 52958,9088, 54141,8125, 55226,7241, 56227,6436,
+    57150,5705, 57986,5036, 58743,4428, 59430,3878, 60066,3387, 60650,2949, 61180,2557, 61648,2204,
+    62066,1889, 62441,1611, 62775,1367, 63074,1152, 63340,965, 63576,803, 63787,664, 63973,544,
+    64139,442, 64285,356, 64415,284, 64529,224, 64631,175, 64721,135, 64802,102, 64873,76,
+    64937,56, 64995,40, 65047,28, 65095,19, 65138,13, 65178,8, 65216,5, 65279,4,
+    65320,2, 65356,1, 65388,1, 65419,0, 65448,0, 65476,0, 65503,0, 65526,0,
+    19461,34998, 14003,28111, 13902,27652, 15425,28108, 17681,28287, 20294,28003, 23061,27291, 25858,26241,
+    28621,24976, 31285,23534, 33840,22025, 36281,20509, 38573,18971, 40746,17494, 42780,16057, 44687,14688,
+    46473,13394, 48138,12175, 49669,11017, 51078,9931, 52381,8926, 53597,8005, 54718,7156, 55737,6369,
+    56666,5647, 57513,4989, 58284,4391, 58989,3851, 59639,3367, 60234,2933, 60764,2541, 61241,2191,
+    61670,1879, 62064,1606, 62432,1368, 62760,1158, 63058,974, 63317,813, 63546,674, 63750,554,
+    63931,452, 64092,365, 64236,292, 64363,231, 64478,181, 64580,140, 64671,107, 64753,80,
+    64828,59, 64895,43, 64956,30, 65012,21, 65064,14, 65112,9, 65157,6, 65199,3,
+    65239,2, 65276,1, 65312,0, 65359,0, 65417,0, 65455,0, 65488,0, 65499,0,
+    21537,33056, 16007,26916, 15438,25992, 16521,26090, 18400,26175, 20697,25957, 23206,25396, 25802,24548,
+    28403,23481, 30957,22265, 33432,20954, 35788,19567, 38038,18186, 40178,16831, 42177,15487, 44063,14205,
+    45832,12982, 47476,11815, 49021,10728, 50453,9705, 51791,8756, 53014,7863, 54134,7033, 55160,6267,
+    56115,5571, 57001,4939, 57808,4360, 58537,3831, 59199,3352, 59798,2920, 60342,2532, 60833,2185,
+    61288,1880, 61704,1610, 62078,1371, 62410,1160, 62707,975, 62973,814, 63211,675, 63444,558,
+    63655,458, 63838,372, 64014,300, 64164,239, 64295,189, 64412,147, 64518,113, 64613,85,
+    64699,63, 64778,46, 64850,33, 64916,23, 64977,16, 65034,10, 65088,7, 65138,4,
+    65185,2, 65230,1, 65272,1, 65312,0, 65349,0, 65383,0, 65427,0, 65449,0,
+    23564,31158, 18049,25741, 17083,24515, 17769,24320, 19286,24278, 21264,24044, 23506,23581, 25879,22880,
+    28302,21988, 30711,20943, 33066,19787, 35354,18590, 37542,17349, 39617,16097, 41587,14872, 43456,13692,
+    45200,12542, 46829,11442, 48368,10413, 49789,9434, 51114,8520, 52355,7675, 53497,6886, 54567,6164,
+    55546,5493, 56436,4872, 57247,4304, 57990,3787, 58681,3323, 59322,2907, 59902,2530, 60422,2190,
+    60891,1886, 61314,1615, 61697,1376, 62041,1165, 62354,981, 62647,823, 62916,686, 63155,567,
+    63366,464, 63555,377, 63724,303, 63876,241, 64019,191, 64171,151, 64300,117, 64411,89,
+    64529,68, 64629,50, 64716,37, 64796,26, 64869,18, 64937,13, 65001,8, 65060,5,
+    65115,3, 65167,2, 65214,1, 65253,1, 65253,0, 65283,0, 65330,0, 65417,0,
+    25530,29318, 20096,24572, 18802,23175, 19132,22749, 20309,22550, 21985,22306, 23951,21870, 26092,21271,
+    28316,20506, 30567,19616, 32791,18612, 34965,17542, 37072,16443, 39101,15338, 41020,14216, 42839,13116,
+    44558,12054, 46188,11044, 47712,10075, 49124,9147, 50446,8279, 51688,7474, 52824,6713, 53885,6013,
+    54875,5370, 55794,4780, 56639,4238, 57420,3744, 58135,3293, 58780,2882, 59366,2509, 59901,2175,
+    60403,1880, 60866,1619, 61287,1386, 61661,1178, 61997,995, 62300,835, 62573,696, 62820,575,
+    63042,472, 63253,385, 63444,312, 63628,251, 63788,199, 63931,156, 64059,121, 64176,92,
+    64283,69, 64389,52, 64492,38, 64600,28, 64690,20, 64774,14, 64863,10, 64934,7,
+    64988,5, 64990,3, 65057,2, 65120,1, 65181,1, 65239,0, 65295,0, 65349,0,
+    27423,27547, 22120,23402, 20561,21928, 20579,21327, 21448,21006, 22829,20693, 24539,20305, 26441,19755,
+    28460,19088, 30531,18305, 32612,17435, 34663,16491, 36670,15514, 38605,14507, 40475,13511, 42260,12524,
+    43941,11542, 45527,10593, 47026,9687, 48444,8832, 49771,8022, 51000,7251, 52141,6530, 53211,5863,
+    54207,5247, 55116,4672, 55957,4144, 56746,3667, 57479,3234, 58155,2840, 58783,2486, 59351,2163,
+    59862,1871, 60331,1611, 60758,1379, 61145,1174, 61515,997, 61853,842, 62167,706, 62443,588,
+    62690,485, 62912,396, 63114,321, 63296,257, 63461,204, 63616,161, 63767,126, 63907,97,
+    64037,74, 64150,56, 64251,41, 64340,29, 64414,21, 64453,14, 64526,10, 64615,7,
+    64715,5, 64803,3, 64893,2, 64984,2, 65062,1, 65133,1, 65201,0, 65264,0,
+    29235,25850, 24100,22235, 22334,20750, 22083,20036, 22673,19614, 23785,19248, 25239,18846, 26914,18346,
+    28724,17742, 30615,17054, 32533,16278, 34452,15449, 36349,14584, 38194,13686, 39977,12777, 41688,11870,
+    43338,10993, 44906,10134, 46380,9295, 47763,8487, 49065,7721, 50295,7003, 51452,6332, 52532,5703,
+    53523,5110, 54444,4562, 55308,4061, 56109,3601, 56839,3177, 57504,2788, 58140,2443, 58719,2130,
+    59250,1848, 59760,1600, 60230,1378, 60648,1179, 61024,1001, 61363,844, 61670,707, 61953,588,
+    62239,489, 62499,404, 62738,331, 62950,268, 63138,214, 63307,170, 63458,132, 63591,102,
+    63704,78, 63787,58, 63876,44, 64002,32, 64125,23, 64234,17, 64334,11, 64428,8,
+    64516,5, 64609,3, 64706,2, 64790,1, 64890,1, 64976,1, 65086,0, 65166,0,
+    30961,24233, 26022,21082, 24097,19623, 23617,18844, 23959,18340, 24825,17929, 26041,17508, 27498,17047,
+    29106,16493, 30812,15869, 32576,15191, 34349,14443, 36121,13669, 37867,12872, 39565,12054, 41214,11243,
+    42790,10428, 44299,9634, 45749,8873, 47126,8139, 48422,7433, 49631,6754, 50767,6115, 51835,5517,
+    52845,4965, 53788,4451, 54664,3973, 55467,3528, 56212,3120, 56912,2752, 57558,2416, 58151,2110,
+    58688,1832, 59190,1585, 59666,1368, 60097,1172, 60494,999, 60872,849, 61221,717, 61539,601,
+    61822,499, 62075,411, 62302,335, 62507,271, 62704,219, 62869,176, 63005,139, 63195,110,
+    63364,85, 63518,64, 63658,48, 63789,35, 63910,25, 64034,18, 64154,13, 64275,9,
+    64388,6, 64489,4, 64582,3, 64670,2, 64769,1, 64863,1, 64944,0, 65051,0,
+    32597,22697, 27870,19950, 25834,18548, 25160,17736, 25284,17176, 25928,16731, 26924,16294, 28166,15827,
+    29587,15335, 31113,14764, 32708,14142, 34346,13490, 35986,12789, 37617,12069, 39219,11333, 40785,10598,
+    42299,9864, 43763,9147, 45154,8438, 46483,7754, 47758,7107, 48962,6486, 50100,5895, 51158,5331,
+    52157,4806, 53085,4313, 53962,3859, 54792,3443, 55563,3059, 56277,2705, 56932,2380, 57538,2084,
+    58106,1819, 58634,1580, 59113,1364, 59552,1171, 59955,1000, 60336,850, 60683,719, 61000,604,
+    61289,504, 61550,419, 61749,346, 61993,282, 62223,228, 62436,182, 62637,144, 62831,113,
+    63028,89, 63209,69, 63379,52, 63536,39, 63679,29, 63810,21, 63943,15, 64066,10,
+    64187,7, 64310,5, 64430,3, 64542,2, 64638,1, 64714,1, 64795,1, 64906,0,
+    34142,21243, 29638,18844, 27528,17517, 26693,16695, 26628,16107, 27070,15624, 27867,15178, 28916,14727,
+    30140,14237, 31501,13733, 32936,13166, 34420,12563, 35937,11945, 37451,11295, 38950,10631, 40426,9965,
+    41866,9302, 43257,8642, 44601,7999, 45895,7378, 47123,6772, 48291,6192, 49415,5649, 50471,5129,
+    51474,4643, 52401,4178, 53273,3747, 54087,3345, 54849,2976, 55571,2639, 56252,2333, 56884,2053,
+    57469,1798, 58003,1566, 58495,1356, 58949,1170, 59374,1005, 59743,856, 60058,725, 60333,610,
+    60673,511, 60983,425, 61264,350, 61546,288, 61812,235, 62061,191, 62284,152, 62494,120,
+    62688,94, 62865,72, 63033,55, 63201,41, 63379,31, 63541,23, 63702,17, 63843,12,
+    63969,9, 64084,6, 64183,4, 64273,3, 64400,2, 64545,1, 64656,1, 64730,0,
+    35595,19869, 31318,17771, 29166,16530, 28202,15714, 27973,15108, 28237,14607, 28852,14159, 29718,13707,
+    30771,13246, 31953,12751, 33242,12251, 34583,11703, 35958,11128, 37359,10551, 38756,9954, 40135,9348,
+    41491,8746, 42812,8147, 44099,7564, 45330,6986, 46516,6431, 47660,5902, 48744,5392, 49771,4906,
+    50759,4454, 51689,4026, 52574,3628, 53394,3252, 54153,2899, 54872,2578, 55535,2279, 56150,2007,
+    56731,1763, 57270,1542, 57760,1342, 58198,1163, 58595,1002, 59030,858, 59433,730, 59825,619,
+    60178,521, 60499,434, 60796,359, 61091,296, 61368,242, 61617,196, 61849,157, 62083,125,
+    62320,100, 62528,78, 62715,60, 62886,45, 63053,34, 63209,25, 63360,18, 63514,14,
+    63643,10, 63796,7, 63934,5, 64070,3, 64192,2, 64316,1, 64412,1, 64520,0,
+    36955,18573, 32905,16735, 30740,15581, 29672,14783, 29303,14178, 29411,13671, 29859,13208, 30562,12769,
+    31450,12321, 32479,11864, 33605,11378, 34815,10893, 36062,10373, 37333,9835, 38621,9297, 39910,8756,
+    41178,8207, 42422,7662, 43638,7128, 44819,6606, 45960,6099, 47050,5605, 48096,5133, 49098,4685,
+    50049,4259, 50951,3857, 51815,3484, 52637,3137, 53405,2812, 54128,2511, 54781,2228, 55382,1968,
+    55929,1733, 56408,1517, 56949,1322, 57468,1149, 57953,994, 58406,854, 58840,731, 59240,622,
+    59612,525, 59955,440, 60293,368, 60600,305, 60884,250, 61143,202, 61399,163, 61652,132,
+    61877,104, 62081,81, 62284,63, 62484,49, 62661,38, 62843,28, 63012,21, 63168,15,
+    63327,11, 63493,8, 63658,6, 63796,4, 63915,3, 64037,2, 64116,1, 64276,0,
+    38224,17355, 34398,15740, 32240,14671, 31094,13902, 30607,13306, 30577,12798, 30878,12337, 31430,11906,
+    32166,11469, 33046,11034, 34034,10586, 35096,10121, 36225,9659, 37383,9175, 38554,8675, 39731,8173,
+    40916,7684, 42081,7190, 43224,6702, 44341,6226, 45423,5761, 46474,5313, 47480,4880, 48441,4463,
+    49362,4069, 50235,3695, 51058,3341, 51829,3009, 52560,2703, 53246,2422, 53858,2160, 54504,1921,
+    55141,1698, 55728,1492, 56287,1306, 56809,1137, 57298,984, 57760,849, 58204,729, 58622,623,
+    59004,528, 59375,446, 59729,374, 60054,312, 60353,257, 60646,211, 60916,172, 61155,138,
+    61364,109, 61578,86, 61812,68, 62026,52, 62222,40, 62417,30, 62619,23, 62802,17,
+    62970,12, 63112,9, 63251,6, 63403,4, 63554,3, 63684,2, 63843,1, 63986,1,
+    39400,16210, 35794,14788, 33662,13802, 32458,13069, 31872,12487, 31723,11985, 31894,11533, 32306,11102,
+    32908,10690, 33648,10267, 34501,9848, 35436,9417, 36430,8976, 37477,8543, 38549,8096, 39626,7638,
+    40703,7178, 41782,6730, 42851,6289, 43895,5853, 44916,5428, 45907,5017, 46861,4619, 47784,4240,
+    48660,3875, 49491,3528, 50276,3202, 50999,2894, 51648,2605, 52372,2333, 53067,2082, 53737,1854,
+    54386,1647, 54997,1456, 55579,1282, 56114,1121, 56614,974, 57093,844, 57535,726, 57951,621,
+    58354,529, 58735,449, 59093,378, 59419,316, 59723,262, 60011,217, 60311,178, 60592,144,
+    60867,116, 61121,93, 61351,73, 61562,56, 61771,44, 61966,33, 62137,25, 62309,18,
+    62489,13, 62680,10, 62834,7, 62973,5, 63152,3, 63335,2, 63514,1, 63660,1,
+    40487,15137, 37092,13881, 35001,12975, 33757,12282, 33091,11715, 32838,11227, 32893,10783, 33183,10365,
+    33656,9961, 34272,9565, 34996,9162, 35809,8761, 36685,8353, 37608,7941, 38575,7538, 39560,7129,
+    40548,6712, 41533,6296, 42511,5888, 43484,5494, 44430,5103, 45354,4727, 46247,4362, 47104,4012,
+    47916,3675, 48685,3359, 49386,3054, 50183,2769, 50949,2502, 51679,2251, 52369,2016, 53024,1798,
+    53638,1594, 54230,1411, 54801,1244, 55351,1094, 55877,959, 56370,835, 56825,721, 57254,621,
+    57655,531, 58014,450, 58355,379, 58715,319, 59056,267, 59380,221, 59681,182, 59967,148,
+    60247,120, 60499,96, 60739,77, 60966,61, 61198,47, 61417,36, 61632,27, 61848,20,
+    62035,15, 62209,11, 62417,8, 62634,6, 62821,4, 62975,2, 63128,1, 63283,1,
+    41485,14132, 38295,13019, 36255,12189, 34987,11535, 34254,10989, 33914,10518, 33867,10085, 34047,9681,
+    34403,9289, 34903,8913, 35511,8532, 36205,8152, 36968,7773, 37782,7391, 38632,7009, 39518,6638,
+    40417,6264, 41316,5886, 42211,5515, 43093,5147, 43962,4791, 44813,4449, 45622,4111, 46395,3789,
+    47115,3481, 47935,3187, 48733,2906, 49510,2643, 50247,2392, 50955,2157, 51639,1940, 52293,1737,
+    52910,1548, 53498,1374, 54048,1212, 54572,1066, 55069,933, 55544,814, 56003,709, 56439,614,
+    56868,528, 57272,451, 57660,383, 58020,323, 58345,270, 58660,224, 58969,186, 59255,152,
+    59531,124, 59819,100, 60098,80, 60366,63, 60615,50, 60863,39, 61077,30, 61296,22,
+    61521,16, 61753,12, 61969,9, 62163,6, 62360,4, 62548,3, 62683,2, 62858,1,
+    42397,13193, 39401,12203, 37421,11442, 36141,10828, 35358,10306, 34943,9853, 34807,9437, 34887,9044,
+    35140,8669, 35528,8303, 36031,7951, 36615,7590, 37270,7235, 37977,6880, 38722,6525, 39498,6173,
+    40301,5833, 41112,5493, 41922,5157, 42718,4822, 43495,4493, 44245,4174, 44961,3868, 45736,3574,
+    46544,3288, 47331,3015, 48098,2757, 48843,2514, 49557,2282, 50249,2066, 50906,1861, 51536,1670,
+    52140,1494, 52720,1332, 53264,1181, 53777,1043, 54248,915, 54728,799, 55190,695, 55621,601,
+    56040,519, 56454,447, 56845,382, 57213,323, 57566,272, 57902,228, 58234,189, 58550,155,
+    58868,127, 59173,103, 59461,83, 59720,66, 59970,52, 60246,41, 60504,31, 60769,24,
+    61015,18, 61236,13, 61447,9, 61653,7, 61814,5, 61989,3, 62212,2, 62377,1,
+    43225,12314, 40414,11432, 38500,10736, 37219,10160, 36397,9666, 35918,9229, 35704,8830, 35697,8454,
+    35854,8095, 36143,7743, 36540,7402, 37027,7073, 37578,6736, 38184,6407, 38831,6079, 39505,5751,
+    40197,5426, 40908,5114, 41624,4809, 42331,4508, 43007,4207, 43676,3916, 44465,3633, 45243,3360,
+    46009,3101, 46753,2850, 47478,2611, 48179,2384, 48854,2168, 49517,1968, 50149,1779, 50758,1603,
+    51329,1436, 51872,1283, 52403,1141, 52937,1012, 53437,892, 53918,784, 54377,684, 54822,593,
+    55255,513, 55660,441, 56042,377, 56444,322, 56832,273, 57201,230, 57552,192, 57891,160,
+    58205,131, 58485,106, 58765,86, 59068,69, 59352,55, 59621,43, 59869,33, 60125,25,
+    60364,19, 60592,14, 60799,10, 60997,7, 61224,5, 61441,3, 61613,2, 61842,1,
+    43970,11494, 41335,10706, 39490,10068, 38218,9529, 37367,9064, 36835,8644, 36553,8264, 36467,7905,
+    36539,7559, 36738,7228, 37039,6901, 37427,6586, 37884,6276, 38390,5965, 38940,5661, 39519,5360,
+    40115,5062, 40712,4761, 41315,4475, 41914,4202, 42582,3932, 43323,3666, 44057,3408, 44776,3156,
+    45483,2914, 46179,2684, 46861,2466, 47516,2255, 48155,2057, 48770,1870, 49349,1691, 49913,1528,
+    50479,1374, 51041,1232, 51581,1099, 52110,976, 52617,863, 53121,763, 53594,670, 54040,585,
+    54478,508, 54899,438, 55306,376, 55699,321, 56071,272, 56437,230, 56789,194, 57110,161,
+    57437,133, 57766,110, 58086,89, 58382,72, 58663,57, 58944,45, 59202,35, 59441,27,
+    59658,20, 59890,15, 60114,11, 60362,8, 60583,5, 60801,3, 61060,2, 61248,1,
+    44637,10730, 42167,10023, 40394,9437, 39137,8936, 38266,8497, 37691,8097, 37349,7733, 37193,7390,
+    37188,7064, 37303,6747, 37518,6439, 37812,6136, 38176,5846, 38590,5558, 39041,5271, 39522,4991,
+    40021,4717, 40524,4446, 41009,4175, 41633,3912, 42309,3664, 42987,3423, 43662,3189, 44324,2959,
+    44978,2738, 45613,2524, 46233,2320, 46837,2127, 47427,1944, 47987,1770, 48567,1607, 49147,1455,
+    49713,1310, 50265,1177, 50801,1054, 51324,942, 51812,835, 52280,738, 52748,648, 53221,569,
+    53674,497, 54103,432, 54518,373, 54902,319, 55265,272, 55609,230, 55966,193, 56324,162,
+    56677,135, 57010,112, 57322,91, 57620,74, 57919,59, 58195,47, 58452,37, 58717,29,
+    58971,22, 59224,16, 59451,12, 59674,8, 59925,6, 60174,4, 60382,2, 60593,1,
+    45227,10017, 42913,9381, 41212,8844, 39976,8378, 39093,7964, 38482,7586, 38088,7235, 37871,6911,
+    37795,6600, 37833,6298, 37967,6009, 38177,5723, 38447,5444, 38772,5177, 39132,4912, 39513,4648,
+    39910,4393, 40307,4144, 40883,3899, 41471,3654, 42065,3417, 42664,3190, 43271,2975, 43873,2766,
+    44462,2562, 45049,2369, 45618,2182, 46163,2003, 46731,1833, 47315,1674, 47885,1523, 48438,1380,
+    48978,1247, 49505,1124, 50003,1008, 50497,901, 50998,802, 51493,713, 51960,630, 52412,553,
+    52832,482, 53250,421, 53656,365, 54048,316, 54453,271, 54833,231, 55194,195, 55541,164,
+    55863,136, 56183,112, 56508,93, 56815,76, 57094,61, 57377,49, 57653,39, 57920,30,
+    58187,23, 58452,17, 58730,13, 58990,9, 59240,6, 59429,4, 59651,3, 59878,1,
+    45744,9352, 43575,8779, 41947,8285, 40737,7853, 39846,7463, 39208,7107, 38770,6773, 38496,6462,
+    38355,6167, 38324,5884, 38381,5606, 38512,5340, 38698,5076, 38930,4819, 39201,4575, 39489,4332,
+    39780,4090, 40277,3858, 40791,3632, 41318,3412, 41844,3192, 42370,2979, 42905,2776, 43437,2581,
+    43969,2397, 44488,2219, 45021,2046, 45590,1884, 46146,1728, 46689,1579, 47224,1440, 47751,1310,
+    48253,1186, 48755,1070, 49262,963, 49759,864, 50236,771, 50699,685, 51146,607, 51586,537,
+    51998,471, 52402,412, 52804,357, 53197,309, 53586,266, 53958,228, 54333,195, 54688,164,
+    55020,138, 55336,114, 55625,94, 55912,77, 56195,62, 56498,50, 56790,40, 57059,31,
+    57346,24, 57620,18, 57886,13, 58154,10, 58387,7, 58627,5, 58866,3, 59101,2,
+    46190,8734, 44158,8215, 42602,7761, 41419,7359, 40527,6992, 39867,6657, 39391,6341, 39067,6043,
+    38868,5764, 38772,5495, 38758,5233, 38812,4979, 38921,4735, 39068,4492, 39243,4257, 39439,4034,
+    39834,3811, 40257,3592, 40699,3381, 41154,3175, 41625,2979, 42095,2785, 42560,2595, 43022,2413,
+    43490,2241, 44019,2076, 44553,1921, 45075,1770, 45593,1628, 46100,1492, 46593,1363, 47084,1241,
+    47583,1126, 48076,1020, 48546,919, 49005,825, 49456,739, 49892,659, 50305,585, 50714,517,
+    51135,455, 51552,400, 51947,350, 52338,304, 52706,261, 53063,224, 53413,191, 53746,162,
+    54066,137, 54383,115, 54690,95, 55004,79, 55298,64, 55575,51, 55870,41, 56168,32,
+    56459,25, 56731,19, 56988,14, 57215,10, 57463,7, 57754,5, 58021,3, 58261,2,
+    46569,8158, 44664,7687, 43178,7270, 42026,6895, 41137,6552, 40459,6236, 39952,5938, 39583,5654,
+    39331,5387, 39174,5131, 39095,4885, 39077,4645, 39109,4413, 39178,4189, 39265,3966, 39538,3751,
+    39878,3547, 40233,3344, 40611,3147, 41004,2958, 41405,2774, 41811,2598, 42221,2427, 42666,2259,
+    43142,2098, 43622,1946, 44098,1800, 44572,1662, 45042,1532, 45502,1405, 45987,1287, 46463,1175,
+    46925,1068, 47378,969, 47820,876, 48252,789, 48660,707, 49058,631, 49479,563, 49884,499,
+    50281,440, 50670,386, 51048,338, 51423,295, 51777,256, 52117,221, 52423,188, 52745,160,
+    53069,135, 53393,114, 53720,95, 54033,79, 54349,65, 54666,52, 54957,42, 55239,33,
+    55525,26, 55793,20, 56041,15, 56330,11, 56594,7, 56863,5, 57108,3, 57360,2,
+    46884,7622, 45097,7194, 43679,6809, 42558,6461, 41676,6139, 40985,5841, 40451,5560, 40044,5291,
+    39744,5036, 39532,4794, 39391,4560, 39307,4335, 39265,4114, 39256,3902, 39396,3696, 39638,3492,
+    39911,3298, 40214,3115, 40527,2933, 40848,2754, 41178,2583, 41537,2420, 41949,2264, 42381,2115,
+    42806,1966, 43229,1823, 43650,1688, 44067,1559, 44508,1437, 44956,1322, 45392,1211, 45821,1107,
+    46247,1010, 46660,918, 47057,831, 47446,750, 47861,675, 48265,605, 48667,540, 49052,479,
+    49432,425, 49800,375, 50149,329, 50483,287, 50807,249, 51150,216, 51480,186, 51808,159,
+    52121,134, 52421,113, 52735,94, 53061,78, 53374,64, 53691,53, 54002,43, 54292,34,
+    54546,26, 54823,20, 55112,15, 55405,11, 55673,8, 55909,5, 56167,3, 56399,2,
+    47137,7124, 45461,6733, 44108,6377, 43020,6053, 42146,5752, 41446,5470, 40889,5206, 40449,4953,
+    40106,4710, 39843,4479, 39645,4258, 39499,4044, 39390,3836, 39382,3635, 39539,3442, 39728,3255,
+    39941,3072, 40174,2897, 40426,2731, 40690,2567, 40986,2408, 41338,2255, 41706,2110, 42080,1971,
+    42460,1839, 42833,1709, 43212,1583, 43612,1463, 44012,1349, 44407,1241, 44799,1140, 45190,1045,
+    45562,953, 45928,868, 46316,788, 46705,713, 47094,643, 47472,577, 47843,517, 48205,461,
+    48555,409, 48885,361, 49215,319, 49547,279, 49873,243, 50190,211, 50519,182, 50836,156,
+    51169,134, 51496,113, 51802,94, 52117,78, 52419,65, 52710,53, 52979,43, 53245,34,
+    53553,27, 53833,21, 54114,16, 54367,12, 54607,8, 54880,6, 55116,4, 55380,2,
+    47333,6660, 45759,6302, 44468,5973, 43413,5671, 42550,5390, 41844,5123, 41268,4875, 40799,4637,
+    40418,4407, 40108,4187, 39858,3976, 39653,3773, 39492,3579, 39559,3389, 39663,3207, 39796,3033,
+    39951,2863, 40123,2697, 40319,2540, 40557,2392, 40853,2247, 41155,2105, 41466,1969, 41780,1838,
+    42101,1715, 42452,1597, 42812,1484, 43167,1374, 43516,1268, 43863,1168, 44203,1073, 44534,983,
+    44876,899, 45238,820, 45599,744, 45959,675, 46315,610, 46661,549, 46996,493, 47317,441,
+    47640,393, 47961,348, 48282,307, 48592,270, 48917,236, 49220,205, 49540,178, 49865,153,
+    50191,131, 50513,111, 50830,94, 51127,79, 51400,65, 51652,53, 51936,43, 52224,35,
+    52507,27, 52772,21, 53018,16, 53270,12, 53541,9, 53784,6, 54049,4, 54304,2,
+    47473,6229, 45994,5901, 44763,5596, 43741,5314, 42890,5050, 42181,4800, 41589,4565, 41094,4340,
+    40679,4123, 40328,3914, 40030,3714, 39774,3523, 39689,3339, 39710,3163, 39763,2991, 39841,2826,
+    39942,2668, 40070,2516, 40236,2369, 40467,2229, 40714,2097, 40966,1967, 41221,1839, 41481,1718,
+    41777,1601, 42082,1491, 42388,1385, 42699,1286, 43000,1189, 43295,1096, 43582,1008, 43902,925,
+    44235,846, 44563,772, 44891,704, 45205,638, 45510,577, 45815,521, 46120,468, 46417,419,
+    46727,375, 47025,334, 47332,295, 47627,260, 47938,228, 48258,199, 48579,173, 48886,149,
+    49182,128, 49467,109, 49750,92, 50014,78, 50298,65, 50585,54, 50862,44, 51123,35,
+    51382,28, 51625,22, 51896,17, 52175,12, 52429,9, 52691,6, 52933,4, 53175,2,
+    47561,5828, 46169,5526, 44995,5243, 44005,4980, 43169,4733, 42459,4498, 41854,4274, 41336,4062,
+    40891,3858, 40503,3660, 40163,3472, 39911,3290, 39853,3118, 39830,2953, 39834,2792, 39864,2638,
+    39923,2490, 40023,2349, 40187,2213, 40364,2080, 40554,1954, 40756,1836, 40969,1720, 41211,1605,
+    41460,1498, 41708,1393, 41956,1293, 42208,1200, 42460,1112, 42717,1027, 43015,947, 43309,870,
+    43598,797, 43883,728, 44159,663, 44437,603, 44714,547, 44977,494, 45254,444, 45526,399,
+    45800,356, 46079,317, 46369,282, 46677,249, 46981,219, 47277,192, 47569,167, 47856,145,
+    48127,125, 48380,107, 48630,90, 48897,76, 49173,63, 49456,53, 49728,43, 49979,35,
+    50235,28, 50494,22, 50770,17, 51015,13, 51270,9, 51508,6, 51760,4, 51997,2,
+    47599,5455, 46289,5176, 45168,4914, 44210,4668, 43388,4435, 42679,4215, 42064,4002, 41527,3802,
+    41055,3610, 40635,3423, 40258,3245, 40078,3075, 39981,2912, 39914,2757, 39878,2609, 39866,2464,
+    39902,2327, 39995,2194, 40112,2067, 40241,1943, 40377,1824, 40532,1710, 40725,1604, 40923,1501,
+    41119,1399, 41318,1303, 41515,1211, 41708,1122, 41938,1038, 42194,961, 42447,887, 42694,816,
+    42941,749, 43187,686, 43432,626, 43670,570, 43906,517, 44154,468, 44391,422, 44647,379,
+    44904,339, 45184,303, 45463,269, 45743,238, 46017,210, 46292,185, 46550,161, 46794,140,
+    47035,120, 47300,104, 47562,88, 47827,75, 48071,62, 48313,52, 48540,42, 48810,35,
+    49079,28, 49337,22, 49569,17, 49815,13, 50051,9, 50287,6, 50517,4, 50774,2,
+    47590,5108, 46355,4850, 45284,4606, 44358,4376, 43551,4157, 42844,3949, 42221,3750, 41668,3560,
+    41173,3377, 40726,3203, 40372,3035, 40205,2875, 40069,2721, 39966,2576, 39889,2437, 39860,2304,
+    39880,2173, 39939,2050, 40010,1931, 40091,1816, 40190,1705, 40321,1597, 40459,1495, 40605,1398,
+    40754,1306, 40902,1216, 41051,1131, 41251,1050, 41451,971, 41653,897, 41858,828, 42064,764,
+    42274,702, 42477,643, 42675,588, 42890,536, 43098,487, 43325,442, 43550,399, 43802,360,
+    44062,323, 44322,288, 44579,257, 44827,228, 45066,201, 45293,177, 45522,155, 45756,135,
+    45995,117, 46239,101, 46482,86, 46728,73, 46955,62, 47185,51, 47422,42, 47666,34,
+    47899,27, 48134,22, 48360,17, 48590,13, 48812,9, 49062,7, 49300,4, 49509,3,
+    47536,4785, 46371,4546, 45348,4319, 44451,4103, 43659,3897, 42957,3701, 42328,3513, 41761,3332,
+    41247,3161, 40774,2998, 40488,2840, 40289,2689, 40122,2545, 39980,2406, 39885,2277, 39836,2153,
+    39837,2032, 39849,1914, 39876,1803, 39919,1696, 39999,1592, 40085,1492, 40175,1396, 40270,1305,
+    40372,1219, 40483,1137, 40640,1058, 40799,982, 40960,910, 41117,841, 41278,776, 41439,714,
+    41602,658, 41767,604, 41942,552, 42121,504, 42318,459, 42524,417, 42763,378, 42999,341,
+    43234,307, 43461,275, 43678,245, 43883,218, 44088,193, 44285,170, 44498,149, 44718,130,
+    44954,113, 45182,98, 45392,84, 45587,71, 45810,60, 46056,50, 46292,42, 46508,34,
+    46702,28, 46908,22, 47123,17, 47346,13, 47578,10, 47785,7, 47985,4, 48208,3,
+    47440,4484, 46339,4263, 45360,4050, 44492,3848, 43717,3655, 43019,3469, 42387,3292, 41808,3121,
+    41277,2960, 40818,2805, 40559,2658, 40333,2516, 40134,2381, 39971,2251, 39848,2128, 39795,2011,
+    39757,1899, 39730,1790, 39716,1684, 39745,1584, 39782,1488, 39823,1395, 39870,1305, 39919,1219,
+    39986,1138, 40100,1062, 40220,990, 40338,920, 40452,853, 40578,790, 40697,729, 40810,672,
+    40937,617, 41076,567, 41228,520, 41384,474, 41579,432, 41784,393, 41987,356, 42183,322,
+    42375,290, 42557,261, 42733,234, 42905,208, 43083,184, 43278,163, 43489,143, 43689,125,
+    43878,109, 44061,94, 44260,81, 44478,70, 44688,59, 44883,49, 45074,41, 45266,34,
+    45473,27, 45673,22, 45876,17, 46085,13, 46272,10, 46465,7, 46680,5, 46876,3,
+    47304,4205, 46262,3999, 45325,3800, 44484,3610, 43724,3428, 43032,3253, 42398,3085, 41811,2925,
+    41265,2771, 40867,2626, 40586,2488, 40335,2355, 40108,2227, 39932,2107, 39809,1991, 39718,1880,
+    39642,1775, 39575,1674, 39552,1574, 39537,1479, 39532,1389, 39533,1303, 39539,1220, 39562,1140,
+    39629,1064, 39700,992, 39772,924, 39851,860, 39935,799, 40011,740, 40086,685, 40188,632,
+    40284,581, 40397,533, 40534,488, 40709,447, 40877,408, 41038,371, 41193,336, 41344,305,
+    41485,274, 41636,247, 41781,221, 41946,198, 42120,176, 42298,156, 42459,137, 42619,120,
+    42780,105, 42956,91, 43141,78, 43327,67, 43508,57, 43679,48, 43837,40, 44024,33,
+    44204,27, 44410,21, 44605,17, 44771,13, 44958,10, 45150,7, 45333,5, 45518,3,
+    47130,3945, 46142,3752, 45245,3566, 44430,3388, 43685,3216, 43000,3051, 42364,2892, 41771,2741,
+    41211,2595, 40872,2459, 40571,2330, 40296,2205, 40059,2086, 39868,1973, 39730,1864, 39603,1758,
+    39488,1658, 39411,1563, 39352,1471, 39298,1381, 39254,1297, 39215,1217, 39198,1140, 39224,1067,
+    39251,996, 39273,927, 39308,863, 39346,803, 39380,746, 39425,693, 39486,640, 39550,592,
+    39634,546, 39760,502, 39891,460, 40015,420, 40141,384, 40262,350, 40374,318, 40486,288,
+    40601,260, 40714,234, 40842,210, 40992,188, 41133,167, 41270,149, 41407,131, 41549,115,
+    41709,101, 41869,87, 42025,75, 42173,65, 42310,55, 42479,46, 42649,39, 42803,32,
+    42978,26, 43140,21, 43296,17, 43473,13, 43636,10, 43800,7, 43963,5, 44140,3,
+    46920,3702, 45982,3523, 45121,3348, 44331,3180, 43601,3018, 42923,2862, 42288,2712, 41689,2570,
+    41180,2433, 40833,2304, 40513,2182, 40219,2066, 39970,1955, 39779,1847, 39610,1744, 39451,1646,
+    39315,1549, 39211,1459, 39117,1373, 39032,1291, 38946,1211, 38883,1135, 38867,1065, 38853,997,
+    38838,931, 38833,869, 38823,807, 38814,750, 38821,697, 38841,646, 38868,599, 38927,553,
+    39024,510, 39123,470, 39216,432, 39302,396, 39379,361, 39456,329, 39538,299, 39610,271,
+    39695,245, 39807,221, 39920,199, 40021,177, 40129,158, 40241,141, 40370,125, 40507,110,
+    40642,96, 40771,84, 40900,73, 41022,63, 41167,53, 41299,45, 41441,38, 41599,31,
+    41739,26, 41863,21, 42004,16, 42150,13, 42304,10, 42441,7, 42602,5, 42747,3,
+    46677,3477, 45784,3308, 44957,3144, 44190,2986, 43475,2833, 42803,2686, 42170,2545, 41566,2410,
+    41112,2282, 40751,2161, 40413,2045, 40113,1935, 39858,1831, 39649,1730, 39450,1633, 39262,1539,
+    39117,1449, 38980,1363, 38852,1282, 38729,1206, 38622,1132, 38560,1061, 38502,993, 38447,930,
+    38404,869, 38361,811, 38314,756, 38281,701, 38257,651, 38252,603, 38282,558, 38343,517,
+    38401,477, 38454,439, 38504,404, 38551,371, 38597,339, 38642,309, 38683,281, 38748,256,
+    38829,231, 38907,209, 38984,187, 39072,168, 39153,150, 39251,134, 39355,118, 39466,105,
+    39571,92, 39672,80, 39773,70, 39889,60, 40002,51, 40126,44, 40241,37, 40347,30,
+    40465,25, 40596,20, 40721,16, 40842,13, 40958,9, 41096,7, 41216,5, 41345,3,
+    46401,3267, 45550,3109, 44754,2954, 44009,2805, 43308,2660, 42644,2521, 42012,2388, 41406,2261,
+    41000,2141, 40627,2026, 40274,1917, 39966,1814, 39713,1716, 39478,1621, 39251,1529, 39058,1441,
+    38884,1356, 38717,1275, 38555,1199, 38408,1127, 38301,1058, 38205,992, 38107,927, 38024,866,
+    37941,810, 37858,756, 37792,705, 37736,656, 37699,608, 37700,564, 37722,522, 37739,482,
+    37752,445, 37767,410, 37775,377, 37791,347, 37802,318, 37816,290, 37858,264, 37911,240,
+    37961,218, 38013,197, 38061,177, 38111,159, 38187,142, 38271,127, 38348,113, 38419,99,
+    38479,87, 38571,77, 38660,67, 38745,58, 38836,49, 38927,42, 39008,36, 39098,30,
+    39192,24, 39292,20, 39409,16, 39508,12, 39614,9, 39717,7, 39829,5, 39938,3,
+    46095,3071, 45282,2922, 44514,2777, 43790,2635, 43102,2499, 42446,2367, 41816,2242, 41252,2122,
+    40847,2009, 40461,1901, 40107,1798, 39794,1701, 39526,1607, 39267,1517, 39026,1431, 38816,1348,
+    38617,1270, 38420,1194, 38233,1121, 38080,1053, 37949,989, 37818,927, 37700,867, 37577,810,
+    37456,756, 37351,705, 37265,657, 37200,613, 37175,570, 37160,528, 37141,489, 37122,452,
+    37098,417, 37069,384, 37046,353, 37015,324, 37007,297, 37027,272, 37048,248, 37064,226,
+    37086,205, 37100,185, 37135,167, 37185,150, 37238,135, 37281,120, 37326,107, 37365,94,
+    37425,83, 37476,73, 37533,63, 37598,55, 37659,47, 37711,40, 37787,34, 37858,29,
+    37941,24, 38015,19, 38083,15, 38175,12, 38266,9, 38347,7, 38441,5, 38533,3,
+    45760,2888, 44982,2748, 44241,2611, 43536,2477, 42860,2348, 42211,2224, 41584,2105, 41066,1993,
+    40654,1886, 40256,1783, 39899,1687, 39589,1595, 39300,1506, 39018,1421, 38772,1339, 38541,1262,
+    38313,1188, 38091,1117, 37894,1050, 37728,985, 37564,924, 37412,866, 37260,812, 37106,758,
+    36967,707, 36846,659, 36745,614, 36687,572, 36643,533, 36593,495, 36541,458, 36482,424,
+    36424,391, 36367,361, 36305,331, 36268,304, 36253,278, 36235,254, 36223,232, 36212,212,
+    36198,192, 36212,174, 36241,157, 36268,142, 36288,127, 36300,114, 36312,101, 36341,90,
+    36363,79, 36399,69, 36429,60, 36459,52, 36494,45, 36545,39, 36585,33, 36651,27,
+    36713,23, 36765,19, 36821,15, 36874,12, 36936,9, 37005,7, 37062,5, 37134,3,
+    45397,2718, 44651,2586, 43935,2456, 43247,2329, 42584,2207, 41942,2090, 41317,1977, 40842,1872,
+    40423,1771, 40023,1674, 39660,1583, 39345,1495, 39036,1411, 38746,1331, 38485,1254, 38230,1182,
+    37978,1112, 37739,1046, 37540,983, 37345,922, 37159,864, 36975,810, 36794,759, 36626,711,
+    36475,663, 36340,618, 36247,576, 36166,536, 36084,498, 36002,463, 35915,430, 35824,397,
+    35736,367, 35650,339, 35588,312, 35544,286, 35492,262, 35451,239, 35402,218, 35364,199,
+    35359,181, 35355,164, 35353,148, 35340,134, 35318,120, 35310,107, 35310,96, 35305,85,
+    35308,75, 35313,66, 35318,58, 35329,50, 35356,43, 35387,37, 35433,32, 35458,26,
+    35471,22, 35508,18, 35548,15, 35588,12, 35618,9, 35656,6, 35701,5, 35745,3,
+    45010,2559, 44293,2434, 43598,2311, 42927,2191, 42275,2075, 41639,1964, 41019,1858, 40581,1759,
+    40154,1663, 39754,1573, 39395,1486, 39064,1402, 38737,1323, 38444,1247, 38164,1175, 37886,1107,
+    37616,1042, 37376,980, 37154,920, 36938,863, 36725,809, 36513,758, 36310,710, 36135,665,
+    35969,622, 35845,580, 35732,540, 35619,502, 35503,466, 35382,433, 35264,402, 35148,372,
+    35034,344, 34947,317, 34872,292, 34797,269, 34729,246, 34655,226, 34595,206, 34561,187,
+    34530,170, 34493,154, 34445,139, 34391,126, 34363,113, 34334,102, 34305,91, 34279,81,
+    34263,71, 34244,63, 34238,55, 34241,48, 34240,41, 34249,35, 34245,30, 34243,25,
+    34250,21, 34258,17, 34265,14, 34280,11, 34303,9, 34325,6, 34348,4, 34371,3,
+    44598,2410, 43907,2292, 43233,2176, 42576,2062, 41934,1951, 41305,1847, 40726,1747, 40284,1653,
+    39850,1562, 39449,1477, 39095,1395, 38748,1316, 38415,1241, 38111,1170, 37808,1102, 37510,1038,
+    37231,976, 36985,918, 36740,862, 36501,808, 36262,757, 36028,709, 35821,664, 35622,621,
+    35468,582, 35331,543, 35192,506, 35047,470, 34895,437, 34747,405, 34598,376, 34457,348,
+    34345,322, 34239,297, 34140,273, 34046,252, 33942,231, 33868,212, 33814,194, 33754,176,
+    33683,160, 33606,145, 33526,131, 33467,118, 33403,106, 33347,95, 33308,85, 33268,76,
+    33234,68, 33205,60, 33178,52, 33156,45, 33138,39, 33103,34, 33064,29, 33045,24,
+    33038,20, 33029,17, 33012,14, 33014,11, 33011,8, 33009,6, 33014,4, 33017,3,
+    44164,2272, 43497,2160, 42841,2049, 42198,1941, 41565,1836, 40942,1737, 40399,1643, 39954,1554,
+    39521,1468, 39121,1388, 38759,1310, 38398,1236, 38065,1165, 37744,1098, 37423,1033, 37110,973,
+    36832,915, 36562,860, 36300,808, 36037,758, 35780,710, 35539,665, 35305,621, 35117,581,
+    34954,543, 34791,508, 34622,474, 34445,441, 34269,409, 34091,379, 33923,351, 33781,325,
+    33649,301, 33528,278, 33403,256, 33271,235, 33181,216, 33101,198, 33016,182, 32920,166,
+    32811,151, 32707,137, 32625,124, 32536,112, 32458,100, 32389,90, 32320,80, 32262,71,
+    32213,64, 32163,56, 32121,50, 32070,43, 32009,37, 31961,32, 31924,28, 31885,23,
+    31849,19, 31820,16, 31808,13, 31776,10, 31744,8, 31719,6, 31700,4, 31685,3,
+    43709,2142, 43063,2036, 42423,1931, 41792,1828, 41169,1729, 40551,1634, 40041,1546, 39591,1461,
+    39160,1380, 38765,1304, 38391,1231, 38022,1161, 37684,1094, 37345,1030, 37008,970, 36692,912,
+    36402,858, 36116,806, 35831,757, 35552,710, 35282,666, 35025,623, 34799,582, 34608,544,
+    34419,508, 34223,474, 34023,443, 33824,413, 33621,383, 33426,355, 33258,329, 33101,304,
+    32954,281, 32801,259, 32650,239, 32536,220, 32427,202, 32310,185, 32188,169, 32057,155,
+    31940,141, 31832,129, 31721,116, 31618,105, 31528,95, 31444,85, 31358,76, 31280,67,
+    31202,60, 31138,53, 31064,47, 30982,41, 30909,35, 30852,31, 30800,26, 30741,22,
+    30690,19, 30644,15, 30592,13, 30544,10, 30498,8, 30458,6, 30416,4, 30379,3,
+    43234,2021, 42607,1920, 41982,1820, 41362,1722, 40746,1628, 40134,1538, 39654,1455, 39199,1374,
+    38768,1298, 38378,1225, 37992,1156, 37624,1090, 37271,1027, 36917,967, 36568,910, 36254,856,
+    35945,804, 35642,755, 35341,709, 35041,666, 34766,624, 34506,585, 34288,546, 34075,510,
+    33854,475, 33630,443, 33404,413, 33180,385, 32965,358, 32774,332, 32594,308, 32421,284,
+    32241,262, 32067,242, 31936,223, 31804,206, 31665,189, 31514,173, 31353,158, 31214,145,
+    31081,132, 30951,120, 30836,109, 30722,99, 30620,89, 30510,80, 30415,72, 30315,64,
+    30222,57, 30118,50, 30008,44, 29920,39, 29843,34, 29759,29, 29679,25, 29612,21,
+    29551,18, 29470,15, 29388,12, 29323,10, 29272,8, 29209,6, 29155,4, 29102,3,
+    42741,1908, 42131,1812, 41519,1716, 40909,1623, 40300,1533, 39696,1449, 39238,1369, 38783,1293,
+    38355,1221, 37961,1152, 37564,1086, 37197,1024, 36829,965, 36461,908, 36113,854, 35787,803,
+    35464,754, 35144,708, 34824,665, 34523,624, 34233,585, 33987,548, 33754,512, 33513,477,
+    33266,445, 33015,414, 32768,386, 32529,359, 32317,335, 32118,311, 31924,288, 31724,266,
+    31531,246, 31377,227, 31221,209, 31057,193, 30883,177, 30700,163, 30538,149, 30377,136,
+    30226,124, 30090,113, 29962,102, 29839,93, 29708,84, 29589,75, 29467,67, 29354,60,
+    29231,54, 29100,47, 28987,42, 28886,36, 28791,32, 28700,28, 28608,24, 28513,20,
+    28408,17, 28317,14, 28236,12, 28156,9, 28073,7, 28002,6, 27930,4, 27856,3,
+    42231,1802, 41635,1710, 41036,1619, 40434,1530, 39832,1445, 39256,1365, 38797,1289, 38343,1217,
+    37920,1148, 37517,1083, 37118,1021, 36742,962, 36361,906, 35984,852, 35638,802, 35296,753,
+    34958,707, 34624,664, 34294,623, 33980,584, 33701,548, 33450,513, 33192,479, 32927,447,
+    32655,416, 32387,387, 32124,361, 31888,336, 31668,313, 31454,291, 31240,270, 31028,250,
+    30855,231, 30677,213, 30488,196, 30290,181, 30083,166, 29903,152, 29726,140, 29554,127,
+    29394,116, 29245,105, 29094,96, 28947,87, 28811,79, 28669,71, 28533,63, 28385,57,
+    28240,51, 28117,45, 27999,40, 27884,35, 27767,30, 27655,26, 27546,23, 27424,19,
+    27307,16, 27210,13, 27120,11, 27027,9, 26921,7, 26827,5, 26732,4, 26643,3,
+    41705,1702, 41123,1615, 40533,1528, 39940,1443, 39342,1363, 38793,1286, 38331,1214, 37879,1145,
+    37460,1081, 37047,1019, 36650,960, 36261,904, 35868,851, 35491,800, 35136,752, 34785,707,
+    34433,663, 34079,622, 33748,584, 33432,547, 33161,513, 32888,480, 32607,449, 32319,419,
+    32035,391, 31752,363, 31487,338, 31246,314, 31011,292, 30779,271, 30549,252, 30358,234,
+    30161,217, 29954,200, 29736,185, 29509,170, 29310,156, 29111,143, 28921,131, 28747,120,
+    28578,109, 28405,99, 28241,90, 28076,81, 27918,74, 27764,67, 27596,60, 27433,53,
+    27294,47, 27163,42, 27034,37, 26897,33, 26761,29, 26625,25, 26482,21, 26357,18,
+    26252,15, 26135,13, 26020,11, 25896,9, 25790,7, 25677,5, 25572,4, 25465,3,
+    41165,1609, 40594,1526, 40013,1443, 39427,1362, 38834,1285, 38308,1212, 37843,1143, 37392,1079,
+    36975,1017, 36554,958, 36158,902, 35758,849, 35357,799, 34981,751, 34615,706, 34250,663,
+    33885,623, 33529,584, 33185,547, 32886,512, 32597,480, 32304,449, 32002,420, 31700,393,
+    31403,366, 31113,341, 30852,317, 30598,294, 30347,273, 30095,254, 29884,236, 29670,219,
+    29446,203, 29210,188, 28964,173, 28749,159, 28531,146, 28325,134, 28134,123, 27947,112,
+    27759,103, 27574,93, 27393,85, 27216,77, 27039,69, 26853,62, 26682,56, 26527,50,
+    26375,45, 26223,40, 26070,35, 25919,31, 25770,27, 25610,24, 25467,20, 25341,17,
+    25211,15, 25079,12, 24929,10, 24804,8, 24677,6, 24563,5, 24441,4, 24324,2,
+    40612,1522, 40050,1442, 39478,1363, 38897,1286, 38308,1212, 37803,1143, 37336,1077, 36890,1016,
+    36469,957, 36047,902, 35642,848, 35232,798, 34826,751, 34449,706, 34074,663, 33698,623,
+    33319,585, 32960,548, 32623,513, 32322,480, 32015,449, 31700,421, 31382,393, 31068,367,
+    30761,343, 30480,320, 30210,297, 29943,276, 29672,256, 29437,238, 29204,220, 28961,204,
+    28708,190, 28448,176, 28216,162, 27982,149, 27757,137, 27550,126, 27348,115, 27144,105,
+    26946,96, 26748,88, 26554,80, 26358,72, 26157,65, 25967,59, 25795,53, 25634,47,
+    25467,42, 25292,38, 25121,33, 24953,29, 24783,26, 24631,22, 24489,19, 24339,16,
+    24185,14, 24034,12, 23897,10, 23752,8, 23620,6, 23483,5, 23353,4, 23220,2,
+    40046,1440, 39494,1364, 38928,1288, 38352,1214, 37767,1144, 37279,1078, 36813,1016, 36371,957,
+    35943,902, 35522,849, 35108,798, 34689,750, 34288,705, 33900,663, 33514,623, 33126,585,
+    32747,549, 32381,515, 32058,482, 31740,450, 31413,421, 31079,394, 30750,368, 30425,344,
+    30122,321, 29838,299, 29559,279, 29276,259, 29017,240, 28767,223, 28506,206, 28235,191,
+    27957,177, 27705,164, 27458,151, 27219,140, 27000,128, 26781,118, 26561,108, 26346,98,
+    26133,90, 25926,82, 25714,75, 25499,68, 25296,61, 25113,55, 24932,49, 24746,44,
+    24558,40, 24376,35, 24194,31, 24008,27, 23839,24, 23687,21, 23525,18, 23360,16,
+    23190,13, 23032,11, 22887,9, 22747,8, 22590,6, 22441,5, 22296,3, 22155,2,
+    39470,1364, 38925,1290, 38364,1217, 37793,1147, 37210,1080, 36739,1018, 36274,958, 35834,902,
+    35399,849, 34978,799, 34555,751, 34131,706, 33730,663, 33335,623, 32939,585, 32538,549,
+    32156,515, 31802,483, 31475,452, 31139,423, 30792,395, 30446,368, 30108,344, 29781,321,
+    29481,300, 29189,280, 28896,261, 28618,243, 28354,226, 28078,209, 27790,193, 27497,178,
+    27226,165, 26962,152, 26707,141, 26475,130, 26242,120, 26012,110, 25783,101, 25552,92,
+    25329,84, 25104,77, 24879,70, 24666,63, 24469,57, 24272,52, 24071,46, 23866,42,
+    23667,37, 23476,33, 23282,30, 23103,26, 22937,23, 22753,20, 22578,17, 22401,15,
+    22233,13, 22070,11, 21906,9, 21746,7, 21589,6, 21432,4, 21281,3, 21128,2,
+    38884,1291, 38345,1221, 37789,1151, 37221,1084, 36649,1020, 36183,960, 35718,904, 35280,851,
+    34839,800, 34417,752, 33986,707, 33560,664, 33156,624, 32753,586, 32347,550, 31947,516,
+    31560,484, 31217,453, 30875,425, 30521,397, 30161,370, 29810,345, 29461,322, 29143,301,
+    28838,281, 28533,262, 28232,245, 27959,228, 27673,212, 27373,196, 27066,181, 26777,167,
+    26498,154, 26230,142, 25982,131, 25734,121, 25490,111, 25247,102, 25004,94, 24769,86,
+    24530,79, 24290,71, 24069,65, 23863,59, 23653,54, 23438,49, 23216,44, 23007,39,
+    22801,35, 22594,31, 22406,28, 22230,25, 22034,21, 21843,19, 21651,16, 21473,14,
+    21308,12, 21135,10, 20957,8, 20776,7, 20613,5, 20454,4, 20293,3, 20139,2,
+};
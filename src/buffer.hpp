@@ -1,11 +1,13 @@
 #pragma once
 
+#include <algorithm>
 #include <stdexcept>
 #include <vector>
 #include <cassert>
 #include <iostream>
 
 #include "logger.hpp"
+#include "parallel.hpp"
 
 template <typename T>
 class Image
@@ -136,16 +138,59 @@ class Image
 template <class T>
 using Image2D = Image<T>;
 
-template<typename T>
+// size of the next mip level, odd sizes are halved with floor so every size has a chain
+inline int NextMipSize(int size)
+{
+    return std::max(1, size >> 1);
+}
+
+// box filter src into a w x h image, texel x of dst averages src texels [x * sw / w, (x + 1) * sw / w)
+// which are 2 texels for even sizes and 2 or 3 for odd ones, rows are filtered in parallel
+template <typename T>
+Image2D<T> DownsampleImage(const Image2D<T> &src, int w, int h)
+{
+    Image2D<T> dst(w, h);
+    const int sw = src.width();
+    const int sh = src.height();
+    parallel_for(0, h, [&](int y) {
+        T *out = dst.data() + static_cast<size_t>(y) * w;
+        // exact halves are 2x2 quads of two adjacent rows, which the compiler vectorizes
+        if (sw == 2 * w && sh == 2 * h)
+        {
+            const T *row0 = src.data() + static_cast<size_t>(2 * y) * sw;
+            const T *row1 = row0 + sw;
+            for (int x = 0; x < w; ++x)
+                out[x] = (row0[2 * x] + row0[2 * x + 1] + row1[2 * x] + row1[2 * x + 1]) * 0.25f;
+            return;
+        }
+        const int y0 = y * sh / h;
+        const int y1 = std::max(y0 + 1, (y + 1) * sh / h);
+        for (int x = 0; x < w; ++x)
+        {
+            const int x0 = x * sw / w;
+            const int x1 = std::max(x0 + 1, (x + 1) * sw / w);
+            T sum{};
+            for (int sy = y0; sy < y1; ++sy)
+                for (int sx = x0; sx < x1; ++sx)
+                    sum += src(sx, sy);
+            out[x] = sum * (1.f / static_cast<float>((x1 - x0) * (y1 - y0)));
+        }
+    });
+    return dst;
+}
+
+// Level is the image type of every level which should offer width() and height(),
+// and DownsampleImage(level, w, h) if the chain is generated from level 0
+template <typename T, typename Level = Image2D<T>>
 class MipMap2D{
   public:
     MipMap2D() = default;
 
-    explicit MipMap2D(const Image2D<T>& lod0_image){
-        generate(lod0_image);
+    explicit MipMap2D(Level lod0_image){
+        generate(std::move(lod0_image));
     }
 
-    void generate(const Image2D<T>& lod0_image);
+    void generate(Level lod0_image);
 
     void generate(int w,int h);
 
@@ -157,74 +202,60 @@ class MipMap2D{
         return levels() > 0;
     }
 
-    const Image2D<T>& get_level(int level) const{
+    int width() const{
+        return images.empty() ? 0 : images.front().width();
+    }
+
+    int height() const{
+        return images.empty() ? 0 : images.front().height();
+    }
+
+    const Level& get_level(int level) const{
         assert(level >=0 && level <levels());
         return images[level];
     }
 
-    Image2D<T>& get_level(int level){
+    Level& get_level(int level){
         assert(level >=0 && level <levels());
         return images[level];
     }
 
   private:
 
-    std::vector<Image2D<T>> images;
+    std::vector<Level> images;
 };
 
-template<typename T>
-void MipMap2D<T>::generate(const Image2D<T> &lod0_image) {
+template <typename T, typename Level>
+void MipMap2D<T, Level>::generate(Level lod0_image) {
     LOG_DEBUG("start generate with : {} {}",lod0_image.width(),lod0_image.height());
     this->images.clear();
     int last_w = lod0_image.width();
     int last_h = lod0_image.height();
-    images.emplace_back(lod0_image);
+    images.emplace_back(std::move(lod0_image));
     while(last_w > 1 && last_h > 1){
-        if((last_w & 1) || (last_h & 1)){
-            this->images.clear();
-            throw std::runtime_error("invalid input image size: must be power of 2");
-        }
-        const int cur_w = last_w >> 1;
-        const int cur_h = last_h >> 1;
-        Image2D<T> cur_lod_image(cur_w,cur_h);
-        auto& last_lod_image = images.back();
-        for(int y = 0; y < cur_h; ++y){
-            const int ly = y << 1;
-            for(int x = 0; x < cur_w; ++x){
-                const int lx = x << 1;
-                const auto t00 = last_lod_image.at(lx,ly);
-                const auto t01 = last_lod_image.at(lx+1,ly);
-                const auto t10 = last_lod_image.at(lx,ly+1);
-                const auto t11 = last_lod_image.at(lx+1,ly+1);
-                cur_lod_image.at(x,y) = (t00 + t01 + t10 + t11) * 0.25f;
-            }
-        }
+        const int cur_w = NextMipSize(last_w);
+        const int cur_h = NextMipSize(last_h);
+        auto cur_lod_image = DownsampleImage(images.back(),cur_w,cur_h);
         images.emplace_back(std::move(cur_lod_image));
-        last_w >>= 1;
-        last_h >>= 1;
+        last_w = cur_w;
+        last_h = cur_h;
     }
     LOG_DEBUG("total mipmap levels: {}",images.size());
 }
 
-template <typename T>
-void MipMap2D<T>::generate(int w,int h)
+template <typename T, typename Level>
+void MipMap2D<T, Level>::generate(int w,int h)
 {
     this->images.clear();
     int last_w = w;
     int last_h = h;
-    images.emplace_back(Image<T>(w,h));
+    images.emplace_back(Level(w,h));
     while(last_w > 1 && last_h > 1){
-        if((last_w & 1) || (last_h & 1)){
-            this->images.clear();
-            throw std::runtime_error("invalid input image size: must be power of 2");
-        }
-        const int cur_w = last_w >> 1;
-        const int cur_h = last_h >> 1;
-        Image2D<T> cur_lod_image(cur_w,cur_h);
-        auto& last_lod_image = images.back();
-        images.emplace_back(std::move(cur_lod_image));
-        last_w >>= 1;
-        last_h >>= 1;
+        const int cur_w = NextMipSize(last_w);
+        const int cur_h = NextMipSize(last_h);
+        images.emplace_back(Level(cur_w,cur_h));
+        last_w = cur_w;
+        last_h = cur_h;
     }
     LOG_DEBUG("total mipmap levels: {}",images.size());
 }
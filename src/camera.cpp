@@ -0,0 +1,36 @@
+#include <array>
+#include <fstream>
+
+#include "camera.hpp"
+
+#include <json.hpp>
+
+std::vector<Camera> LoadCameraPath(const std::string &filename)
+{
+    std::ifstream in(filename);
+    if (!in.is_open())
+    {
+        throw std::runtime_error("open camera path file failed");
+    }
+    nlohmann::json j;
+    in >> j;
+    in.close();
+    std::vector<Camera> cameras;
+    for (auto &frame : j.at("frames"))
+    {
+        Camera camera;
+        std::array<float, 3> position = frame.at("position");
+        std::array<float, 3> target = frame.at("target");
+        camera.position = {position[0], position[1], position[2]};
+        camera.target = {target[0], target[1], target[2]};
+        if (frame.find("fov") != frame.end())
+        {
+            camera.fov = frame.at("fov");
+        }
+        camera.front = normalize(camera.target - camera.position);
+        camera.right = normalize(cross(camera.front, camera.world_up));
+        camera.up = normalize(cross(camera.right, camera.front));
+        cameras.emplace_back(camera);
+    }
+    return cameras;
+}
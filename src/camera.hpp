@@ -1,5 +1,8 @@
 #pragma once
 
+#include <string>
+#include <vector>
+
 #include "common.hpp"
 
 class Camera
@@ -48,3 +51,6 @@ inline mat4 Camera::getProjMatrix() const
 {
     return glm::perspective(glm::radians(fov * 0.5f), aspect, z_near, z_far);
 }
+
+// read cameras from json file like {"frames":[{"position":[x,y,z],"target":[x,y,z],"fov":20}]}
+std::vector<Camera> LoadCameraPath(const std::string &filename);
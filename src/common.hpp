@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cmath>
 #include <memory>
 
 #include <glm/glm.hpp>
@@ -13,6 +14,7 @@ class Scene;
 class Displayer;
 class SoftRenderer;
 class InputProcessor;
+class SceneLoader;
 class Engine;
 
 
@@ -68,6 +70,47 @@ inline float2 sampleSphericalMap(const float3& dir) {
     uv += 0.5f;//(0,1)
     return uv;
 }
+// octahedral mapping folds the unit sphere onto [0,1]^2 with only divisions and selects,
+// upper hemisphere (y > 0) is the inner diamond and dir need not be normalized
+inline float2 octahedralEncode(const float3& dir){
+    float3 n = dir / (std::abs(dir.x) + std::abs(dir.y) + std::abs(dir.z));
+    float2 p = float2(n.x,n.z);
+    if(n.y < 0.f){
+        p = float2((1.f - std::abs(n.z)) * (n.x >= 0.f ? 1.f : -1.f),
+                   (1.f - std::abs(n.x)) * (n.z >= 0.f ? 1.f : -1.f));
+    }
+    return p * 0.5f + 0.5f;
+}
+inline float3 octahedralDecode(const float2& uv){
+    float2 p = uv * 2.f - 1.f;
+    float3 n = float3(p.x,1.f - std::abs(p.x) - std::abs(p.y),p.y);
+    if(n.y < 0.f){
+        n.x = (1.f - std::abs(p.y)) * (p.x >= 0.f ? 1.f : -1.f);
+        n.z = (1.f - std::abs(p.x)) * (p.y >= 0.f ? 1.f : -1.f);
+    }
+    return normalize(n);
+}
+// direction held by texel (x, y) of a size x size octahedral map, texels sit on uv i / (size - 1)
+// so border texels mirrored by the folding hold the same direction and bilinear lookup has no seam
+inline float3 octahedralTexelDirection(int x,int y,int size){
+    if(size == 1)
+        return octahedralDecode({0.5f,0.5f});
+    const float inv = 1.f / static_cast<float>(size - 1);
+    return octahedralDecode({x * inv,y * inv});
+}
+// real spherical harmonics of band 0 to 2 at unit direction (x, y, z), V is float or vfloat
+template <typename V>
+inline void SHBasis9(const V& x,const V& y,const V& z,V* sh){
+    sh[0] = V(0.282095f);
+    sh[1] = 0.488603f * y;
+    sh[2] = 0.488603f * z;
+    sh[3] = 0.488603f * x;
+    sh[4] = 1.092548f * x * y;
+    sh[5] = 1.092548f * y * z;
+    sh[6] = 0.315392f * (3.f * z * z - 1.f);
+    sh[7] = 1.092548f * x * z;
+    sh[8] = 0.546274f * (x * x - y * y);
+}
 inline float3 sampleEquirectangularMap(const float2& uv){
     //local coord but world up is (0,1,0) not (0,0,1)
     float phi = uv.x * 2 * PI;
@@ -22,6 +22,14 @@ void Displayer::draw(const Image<color4b> &pixels)
     SDL_RenderPresent(renderer);
 }
 
+void Displayer::setTitle(const std::string &title)
+{
+    if (title == window_title)
+        return;
+    window_title = title;
+    SDL_SetWindowTitle(window, window_title.c_str());
+}
+
 void Displayer::initSDL()
 {
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER) < 0)
@@ -30,7 +38,8 @@ void Displayer::initSDL()
         throw std::runtime_error("SDL could not initialize");
     }
 
-    window = SDL_CreateWindow("SoftPBRRenderer", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
+    window_title = "SoftPBRRenderer";
+    window = SDL_CreateWindow(window_title.c_str(), SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
                               ScreenWidth,ScreenHeight, 0);
     if (!window)
     {
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <string>
+
 #include <SDL.h>
 
 #include "buffer.hpp"
@@ -14,6 +16,9 @@ class Displayer
 
     void draw(const Image<color4b> &pixels);
 
+    // window title is only updated if it changes
+    void setTitle(const std::string &title);
+
   private:
     void initSDL();
 
@@ -22,4 +27,5 @@ class Displayer
     SDL_Window *window;
     SDL_Renderer *renderer;
     SDL_Texture *texture;
+    std::string window_title;
 };
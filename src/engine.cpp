@@ -1,16 +1,25 @@
+#include <filesystem>
+#include <iomanip>
+#include <sstream>
+
 #include "engine.hpp"
 #include "displayer.hpp"
+#include "image_writer.hpp"
 #include "input.hpp"
 #include "renderer.hpp"
+#include "scene_loader.hpp"
 #include "util.hpp"
 #include "shader.hpp"
 
-void Engine::startup()
+void Engine::startup(bool headless)
 {
     scene = std::make_shared<Scene>();
-    displayer = std::make_unique<Displayer>();
+    if(!headless){
+        displayer = std::make_unique<Displayer>();
+        scene_loader = std::make_unique<SceneLoader>();
+        input_processor = std::make_unique<InputProcessor>(scene,*scene_loader);
+    }
     soft_renderer = std::make_unique<SoftRenderer>(scene);
-    input_processor = std::make_unique<InputProcessor>(scene);
     LOG_INFO("engine startup...");
 }
 
@@ -50,14 +59,70 @@ static void update_pbr_shader(PBRShader& pbr_shader,const Model& model){
 }
 
 static void update_sky_shader(SkyShader& sky_shader,const Model& model){
-    sky_shader.envMap = model.getEnvironmentMap().get();
-    sky_shader.model  = model.getModelMatrix();
-
+    sky_shader.skyMap = &model.getSkyMap();
 }
 static void update_ibl_shader(IBLShader& ibl_shader,const Model& model){
     ibl_shader.irradiance_map = &model.getIBL().irradiance_map;
+    ibl_shader.irradiance_sh  = use_sh_irradiance ? &model.getIBL().irradiance_sh : nullptr;
     ibl_shader.prefilter_map  = &model.getIBL().prefilter_map;
-    ibl_shader.brdf_lut       = &model.getIBL().brdf_lut;
+    ibl_shader.brdf_lut       = use_analytic_brdf ? nullptr : &getBRDFLUT();
+}
+
+void Engine::renderFrame()
+{
+    static PBRShader pbr_shader;
+    static SkyShader sky_shader;
+    static IBLShader ibl_shader;
+
+    update_pbr_shader(pbr_shader,*scene);
+    update_sky_shader(sky_shader,*scene);
+    update_pbr_shader(ibl_shader,*scene);
+
+    START_TIMER
+    //it's maybe some expensive for clear hierarchical zbuffer
+    soft_renderer->clearFrameBuffer();
+    STOP_TIMER("clear framebuffer")
+
+    START_TIMER
+
+    Timer cull_timer;
+    cull_timer.start();
+    auto models = scene->getVisibleModels();
+    cull_timer.stop();
+    soft_renderer->getStats().cull += cull_timer.duration().ms().count();
+
+    auto sky_box = scene->getSkyBox();
+    if(sky_box){
+        update_ibl_shader(ibl_shader,*sky_box);
+
+        //every model keeps its own shader because deferred shading runs them after all draws
+        static std::vector<IBLShader> model_shaders;
+        model_shaders.assign(models.size(),ibl_shader);
+        for(size_t i = 0; i < models.size(); ++i){
+            update_pbr_shader(model_shaders[i],*models[i]);
+            soft_renderer->render(model_shaders[i],*models[i],true);
+        }
+
+        //sky only fills pixels no model covers, so it runs after models and needs no geometry
+        update_sky_shader(sky_shader,*sky_box);
+        soft_renderer->renderBackground(sky_shader);
+    }
+    else{
+        static std::vector<PBRShader> model_shaders;
+        model_shaders.assign(models.size(),pbr_shader);
+        for(size_t i = 0; i < models.size(); ++i){
+            update_pbr_shader(model_shaders[i],*models[i]);
+            soft_renderer->render(model_shaders[i],*models[i],true);
+        }
+    }
+
+    //shade visibility buffer if deferred shading is on
+    soft_renderer->resolve();
+
+    //this method is just suit for direct lighting and no more use
+    //soft_renderer->render();
+
+    STOP_TIMER("render a frame")
 }
 
 void Engine::run()
@@ -69,54 +134,21 @@ void Engine::run()
 
     while (!exit)
     {
-        static PBRShader pbr_shader;
-        static SkyShader sky_shader;
-        static IBLShader ibl_shader;
-
-        update_pbr_shader(pbr_shader,*scene);
-        update_sky_shader(sky_shader,*scene);
-        update_pbr_shader(ibl_shader,*scene);
-
         last_t = SDL_GetTicks();
 
         input_processor->processInput(exit, delta_t);
 
-        START_TIMER
-        //it's maybe some expensive for clear hierarchical zbuffer
-        soft_renderer->clearFrameBuffer();
-        STOP_TIMER("clear framebuffer")
-
-        START_TIMER
-
-        auto sky_box = scene->getSkyBox();
-        if(sky_box){
-            update_ibl_shader(ibl_shader,*sky_box);
-
-            auto models = scene->getVisibleModels();
-            for(auto model:models){
-                update_pbr_shader(ibl_shader,*model);
-                soft_renderer->render(ibl_shader,*model,true);
-            }
-
-            //cube's vertex behind view point if perform mvp transform will cause error
-            //opengl will clip these primitive and reconstruct them
-            //this algorithm should be some hard
-            //So I just use sphere to replace a cube with enough small triangle
-            update_sky_shader(sky_shader,*sky_box);
-            soft_renderer->render(sky_shader,*sky_box);
+        //files dropped are loaded in background and previous scene is rendered until they finish
+        scene_loader->apply(*scene);
+        if(scene_loader->busy()){
+            displayer->setTitle("SoftPBRRenderer - loading " +
+                                std::to_string(static_cast<int>(scene_loader->progress() * 100.f)) + "%");
         }
         else{
-            auto models = scene->getVisibleModels();
-            for(auto model:models){
-                update_pbr_shader(pbr_shader,*model);
-                soft_renderer->render(pbr_shader,*model,true);
-            }
+            displayer->setTitle("SoftPBRRenderer");
         }
 
-        //this method is just suit for direct lighting and no more use
-        //soft_renderer->render();
-
-        STOP_TIMER("render a frame")
+        renderFrame();
 
         START_TIMER
         //copy result image and draw it
@@ -126,6 +158,40 @@ void Engine::run()
         delta_t = SDL_GetTicks() - last_t;
     }
 }
+
+void Engine::runHeadless(const std::string &scene_file, const std::string &camera_path_file,
+                         const std::string &output_dir)
+{
+    scene->loadScene(scene_file);
+    auto cameras = LoadCameraPath(camera_path_file);
+    std::filesystem::create_directories(output_dir);
+    LOG_INFO("headless render {} frames into {}",cameras.size(),output_dir);
+
+    //frame n is encoded on writer thread while frame n + 1 is rendering
+    ImageWriter writer;
+    for (size_t i = 0; i < cameras.size(); ++i)
+    {
+        scene->setCamera(cameras[i]);
+
+        renderFrame();
+
+        std::ostringstream name;
+        name << "frame_" << std::setw(4) << std::setfill('0') << i << ".png";
+        writer.write((std::filesystem::path(output_dir) / name.str()).string(), soft_renderer->getImage());
+    }
+    writer.wait();
+}
+
+const RC<Scene> &Engine::getScene() const
+{
+    return scene;
+}
+
+SoftRenderer &Engine::getRenderer()
+{
+    return *soft_renderer;
+}
+
 Engine &Engine::getInstance()
 {
     static Engine engine;
@@ -18,12 +18,24 @@ class Engine final
 
     static Engine& getInstance();
 
-    void startup();
+    // headless engine creates neither window nor input processor
+    void startup(bool headless = false);
 
     void run();
 
+    // render scene from every camera of camera path file and write frames into output_dir without SDL
+    void runHeadless(const std::string &scene_file, const std::string &camera_path_file,
+                     const std::string &output_dir);
+
     void shutdown();
 
+    // render current scene once into framebuffer of soft renderer
+    void renderFrame();
+
+    const RC<Scene> &getScene() const;
+
+    SoftRenderer &getRenderer();
+
   private:
 
     RC<Scene> scene;
@@ -33,4 +45,6 @@ class Engine final
     Box<SoftRenderer> soft_renderer;
 
     Box<InputProcessor> input_processor;
+
+    Box<SceneLoader> scene_loader;
 };
@@ -1,253 +1,152 @@
-#include <iostream>
-#include <queue>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
 #include <vector>
-//#include <omp.h>
 
 #include "zbuffer.hpp"
-#include "parallel.hpp"
 #include "logger.hpp"
 
+// hierarchical zbuffer stored as a max depth mip pyramid in one flat array
+// level 0 is the per pixel depth and every cell of level l keeps the max depth of its 2x2 kids in level l - 1
+// coarser levels are only refreshed by updateHierarchy so writing a fragment costs no more than naive zbuffer
 struct HierarchicalZBuffer::Impl
 {
-    Impl(int w, int h)
+    Impl(int w, int h, int max_cell_size)
     {
-        quad_tree = std::make_unique<QuadTree>();
-        quad_tree->buildQuadTree(w, h);
-    }
-
-    ~Impl() = default;
-
-    class QuadTree
-    {
-      public:
-        struct QuadNode
-        {
-            QuadNode *kids[4];
-            QuadNode *parent;
-            int level;
-            float depth;
-            BoundBox2D box;
-        };
-
-        // build quad tree from bottom to top
-        void buildQuadTree(int base_x, int base_y, int base_len = 1)
-        {
-            int leaf_num_x = (base_x + base_len - 1) / base_len;
-            int leaf_num_y = (base_y + base_len - 1) / base_len;
-            int leaf_count = leaf_num_x * leaf_num_y;
-            using Array2D = std::vector<std::vector<QuadNode *>>;
-
-            std::vector<std::vector<QuadNode *>> leaf_nodes;
-            leaf_nodes.resize(leaf_num_y);
-            for (int y = 0; y < leaf_num_y; y++)
-            {
-                leaf_nodes[y].resize(leaf_num_x);
-                for (int x = 0; x < leaf_num_x; x++)
-                {
-                    auto node = new QuadNode();
-                    node->box = BoundBox2D{
-                        float2{static_cast<float>(x * base_len), static_cast<float>(y * base_len)},
-                        float2{static_cast<float>((x + 1) * base_len), static_cast<float>((y + 1) * base_len)}};
-                    node->level = 0;
-                    node->depth = 1.f; // max depth for vertex after mvp is 1.f
-                    leaf_nodes[y][x] = node;
-                }
-            }
-
-            int last_level_x = leaf_num_x;
-            int last_level_y = leaf_num_y;
-            auto get_kid = [](const Array2D &nodes, int x, int y, int i, int j) -> QuadNode * {
-                if (i < x && j < y){
-                    return nodes[j][i];
-                }
-                else{
-                    return nullptr;
-                }
-            };
-            Array2D last_level_nodes = std::move(leaf_nodes);
-            do
-            {
-                int level_x = (last_level_x + 1) / 2;
-                int level_y = (last_level_y + 1) / 2;
-                Array2D level_nodes;
-
-                level_nodes.resize(level_y);
-                for (int y = 0; y < level_y; y++)
-                {
-                    level_nodes[y].resize(level_x);
-                    for (int x = 0; x < level_x; x++)
-                    {
-                        auto node = new QuadNode();
-                        node->kids[0] = get_kid(last_level_nodes, last_level_x, last_level_y, x * 2, y * 2);
-                        node->kids[1] = get_kid(last_level_nodes, last_level_x, last_level_y, x * 2 + 1, y * 2);
-                        node->kids[2] = get_kid(last_level_nodes, last_level_x, last_level_y, x * 2, y * 2 + 1);
-                        node->kids[3] = get_kid(last_level_nodes, last_level_x, last_level_y, x * 2 + 1, y * 2 + 1);
-                        auto box = node->kids[0]->box;
-                        for (int i = 1; i < 4; i++)
-                        {
-                            if (node->kids[i])
-                            {
-                                box = UnionBoundBox(box, node->kids[i]->box);
-                            }
-                        }
-                        node->box = box;
-                        for (int i = 0; i < 4; i++){
-                            if (node->kids[i]){
-                                node->kids[i]->parent = node;
-                            }
-                        }
-                        node->level = node->kids[0]->level + 1;
-                        node->depth = 1.f;
-                        level_nodes[y][x] = node;
-                    }
-                }
-                last_level_x = level_x;
-                last_level_y = level_y;
-                this->level_leaf_nodes.emplace_back(std::move(last_level_nodes));
-                last_level_nodes = std::move(level_nodes);
-            } while (last_level_x > 1 || last_level_y > 1);
-            assert(last_level_x == 1 && last_level_y == 1);
-            root = last_level_nodes[0][0];
-            this->level_leaf_nodes.emplace_back(std::move(last_level_nodes));
-            levels = root->level + 1;
-            assert(root->parent == nullptr);
-            LOG_DEBUG("root level: {}",root->level);
-            LOG_DEBUG("quad tree hor hierarchical zbuffer build successfully");
-        }
-
-        void destroy()
-        {
-            std::queue<QuadNode *> q;
-            q.push(root);
-            while (!q.empty())
-            {
-                auto p = q.front();
-                q.pop();
-                if (!p)
-                    continue;
-                for (int i = 0; i < 4; i++)
-                {
-                    q.push(p->kids[i]);
-                }
-                delete p;
-            }
-        }
-
-        // very cost time
-        void clear(QuadNode *node)
-        {
-            if (!node)
-                return;
-            node->depth = 1.f;
-            for (int i = 0; i < 4; i++)
-            {
-                clear(node->kids[i]);
-            }
-        }
-
-        void clear()
-        {
-            //clear(root);
-            for (int l = 0; l < level_leaf_nodes.size(); l++)
-            {
-                parallel_forrange(0,(int)level_leaf_nodes[l].size(),[&](int,int row){
-                    for (int col = 0; col < level_leaf_nodes[l][row].size(); col++)
-                    {
-                        level_leaf_nodes[l][row][col]->depth = std::numeric_limits<float>::max();
-                    }
-                });
-//#pragma omp parallel for
-//                for (int row = 0; row < level_leaf_nodes[l].size(); row++)
-//                {
-//                    for (int col = 0; col < level_leaf_nodes[l][row].size(); col++)
-//                    {
-//                        level_leaf_nodes[l][row][col]->depth = std::numeric_limits<float>::max();
-//                    }
-//                }
-            }
-        }
-
-        ~QuadTree()
+        int offset = 0;
+        for (int cell_size = 1; ; cell_size *= 2)
         {
-            destroy();
+            Level level;
+            level.w = (w + cell_size - 1) / cell_size;
+            level.h = (h + cell_size - 1) / cell_size;
+            level.offset = offset;
+            offset += level.w * level.h;
+            levels.emplace_back(level);
+            if (cell_size >= max_cell_size)
+                break;
         }
+        depth.resize(offset);
+        const auto &top = levels.back();
+        dirty.resize(top.w * top.h);
+        top_shift = static_cast<int>(levels.size()) - 1;
+        clear();
+        LOG_DEBUG("hierarchical zbuffer levels: {}",levels.size());
+    }
 
-        bool isLeafNode(QuadNode *node) const
-        {
-            return !node->kids[0];
-        }
-
-        QuadNode *root;
-
-        int levels; // level count = max level + 1
-
-        // for quickly clear because recursive clear root node can't use parallel speedup
-        std::vector<std::vector<std::vector<QuadNode *>>> level_leaf_nodes;
+    struct Level
+    {
+        int w, h;
+        int offset;
     };
 
-    Box<QuadTree> quad_tree;
+    float *level(int l)
+    {
+        return depth.data() + levels[l].offset;
+    }
+
+    const float *level(int l) const
+    {
+        return depth.data() + levels[l].offset;
+    }
 
-    // test for entire triangle
+    // test for entire triangle, box is in pixel and inclusive
     bool zTest(const BoundBox2D &box, float zVal) const
     {
-        auto node = quad_tree->root;
-        if (!BoundBox2DContainTest(node->box, box))
+        int x0 = std::max(static_cast<int>(box.min_p.x), 0);
+        int y0 = std::max(static_cast<int>(box.min_p.y), 0);
+        int x1 = std::min(static_cast<int>(box.max_p.x), levels[0].w - 1);
+        int y1 = std::min(static_cast<int>(box.max_p.y), levels[0].h - 1);
+        if (x0 > x1 || y0 > y1)
             return true;
-        while (!quad_tree->isLeafNode(node))
+
+        // pick the finest level where box covers at most 2x2 cells
+        int extent = std::max(x1 - x0, y1 - y0);
+        int l = 0;
+        while ((1 << l) <= extent && l < top_shift)
+            l++;
+        const auto &lv = levels[l];
+        const float *d = level(l);
+        float max_depth = 0.f;
+        for (int y = y0 >> l; y <= y1 >> l; y++)
         {
-            if (node->depth < zVal)
-                return false;
-            int i;
-            for (i = 0; i < 4; i++)
+            for (int x = x0 >> l; x <= x1 >> l; x++)
             {
-                if (node->kids[i] && BoundBox2DContainTest(node->kids[i]->box, box))
-                {
-                    node = node->kids[i];
-                    break;
-                }
-            }
-            if (i == 4)
-            {
-                return true;
+                max_depth = std::max(max_depth, d[y * lv.w + x]);
             }
         }
+        return zVal < max_depth;
     }
 
     // for quick frag test
     bool zTest(int x, int y, float zVal) const
     {
-        return quad_tree->level_leaf_nodes[0][y][x]->depth > zVal && zVal >= 0.f && zVal <= 1.f;
+        return zVal >= 0.f && zVal <= 1.f && zVal < depth[y * levels[0].w + x];
     }
 
     void updateZBuffer(int x, int y, float zVal)
     {
-        auto leaf = quad_tree->level_leaf_nodes[0][y][x];
-        leaf->depth = zVal;
-        auto p = leaf->parent;
-        while (p)
+        depth[y * levels[0].w + x] = zVal;
+        dirty[(y >> top_shift) * levels.back().w + (x >> top_shift)] = 1;
+    }
+
+    // rebuild coarser levels of dirty top level cells overlapped with [xMin,xMax]x[yMin,yMax]
+    // different top level cells share nothing so disjoint regions can be updated concurrently
+    void updateHierarchy(int xMin, int yMin, int xMax, int yMax)
+    {
+        const int top_w = levels.back().w;
+        for (int ty = yMin >> top_shift; ty <= yMax >> top_shift; ty++)
         {
-            if (zVal > p->depth)
-            {
-                p->depth = zVal;
-            }
-            else
+            for (int tx = xMin >> top_shift; tx <= xMax >> top_shift; tx++)
             {
-                p->depth = std::max({p->kids[0] ? p->kids[0]->depth : 0.f, p->kids[1] ? p->kids[1]->depth : 0.f,
-                                     p->kids[2] ? p->kids[2]->depth : 0.f, p->kids[3] ? p->kids[3]->depth : 0.f});
+                auto &flag = dirty[ty * top_w + tx];
+                if (!flag)
+                    continue;
+                flag = 0;
+                for (int l = 1; l <= top_shift; l++)
+                {
+                    const int span = 1 << (top_shift - l);
+                    const auto &kid = levels[l - 1];
+                    const auto &lv = levels[l];
+                    const float *src = level(l - 1);
+                    float *dst = level(l);
+                    const int y_end = std::min((ty + 1) * span, lv.h);
+                    const int x_end = std::min((tx + 1) * span, lv.w);
+                    for (int y = ty * span; y < y_end; y++)
+                    {
+                        const int ky0 = y * 2, ky1 = std::min(y * 2 + 1, kid.h - 1);
+                        for (int x = tx * span; x < x_end; x++)
+                        {
+                            const int kx0 = x * 2, kx1 = std::min(x * 2 + 1, kid.w - 1);
+                            dst[y * lv.w + x] = std::max({src[ky0 * kid.w + kx0], src[ky0 * kid.w + kx1],
+                                                          src[ky1 * kid.w + kx0], src[ky1 * kid.w + kx1]});
+                        }
+                    }
+                }
             }
-            p = p->parent;
         }
     }
 
     void clear()
     {
-        quad_tree->clear();
+        std::fill(depth.begin(), depth.end(), std::numeric_limits<float>::max());
+        std::fill(dirty.begin(), dirty.end(), 0);
     }
+
+    std::vector<Level> levels;
+
+    // all levels from fine to coarse
+    std::vector<float> depth;
+
+    // top level cells written since their coarser levels were rebuilt
+    std::vector<uint8_t> dirty;
+
+    // log2 of top level cell size
+    int top_shift;
 };
 
-HierarchicalZBuffer::HierarchicalZBuffer(int w, int h)
+HierarchicalZBuffer::HierarchicalZBuffer(int w, int h, int maxCellSize)
 {
-    impl = newBox<Impl>(w, h);
+    impl = newBox<Impl>(w, h, maxCellSize);
 }
 
 HierarchicalZBuffer::~HierarchicalZBuffer()
@@ -265,6 +164,11 @@ void HierarchicalZBuffer::updateZBuffer(int x, int y, float zVal)
     impl->updateZBuffer(x, y, zVal);
 }
 
+void HierarchicalZBuffer::updateHierarchy(int xMin, int yMin, int xMax, int yMax)
+{
+    impl->updateHierarchy(xMin, yMin, xMax, yMax);
+}
+
 void HierarchicalZBuffer::clear()
 {
     impl->clear();
@@ -0,0 +1,201 @@
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "ibl_cache.hpp"
+#include "logger.hpp"
+
+std::string ibl_cache_dir = "ibl_cache";
+
+namespace
+{
+// bump it whenever precomputation or file layout changes
+// 2: irradiance and prefilter map in octahedral layout
+// 3: raw RGB9E5 texels in tiled order instead of float channels
+// 4: checksum of everything after the header
+constexpr uint32_t CacheVersion = 4;
+constexpr uint32_t CacheMagic   = 0x4c424953; // "SIBL"
+
+struct CacheHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    uint32_t image_count;
+    uint32_t reserved;
+    // Fnv1a of image headers and texels
+    uint64_t checksum;
+};
+
+struct CacheImageHeader
+{
+    int32_t w;
+    int32_t h;
+    int32_t texel_size;
+    int32_t reserved;
+};
+
+// raw texels of an image to save or to fill
+struct CacheImage
+{
+    int w, h, texel_size;
+    size_t bytes;
+    void *data;
+};
+
+template <typename Format>
+CacheImage ToCacheImage(const PackedTexture<Format> &image)
+{
+    using Texel = typename Format::Texel;
+    return {image.width(), image.height(), static_cast<int>(sizeof(Texel)), image.byteSize(),
+            const_cast<Texel *>(image.data())};
+}
+
+uint64_t Fnv1a(const void *data, size_t size, uint64_t hash = 14695981039346656037ull)
+{
+    auto p = static_cast<const uint8_t *>(data);
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= p[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+std::string CachePath(const char *name, uint64_t key)
+{
+    std::ostringstream os;
+    os << name << "_" << std::hex << key << ".bin";
+    return (std::filesystem::path(ibl_cache_dir) / os.str()).string();
+}
+
+// unique per writer so concurrent loads of the same environment map never write into one temporary file
+std::string TempPath(const std::string &path)
+{
+    std::ostringstream os;
+    os << path << "." << std::this_thread::get_id() << "_" << std::hex << std::random_device{}() << ".tmp";
+    return os.str();
+}
+
+// images should be allocated with expected sizes, any mismatch means the cache is stale.
+// texels are read straight into the images, they own their storage as the same maps are filled by precompute
+bool ReadCache(const std::string &path, uint64_t key, const std::vector<CacheImage> &images)
+{
+    if (ibl_cache_dir.empty() || !std::filesystem::exists(path))
+        return false;
+    try
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (!in.is_open())
+            return false;
+
+        CacheHeader header;
+        if (!in.read(reinterpret_cast<char *>(&header), sizeof(header)))
+            return false;
+        if (header.magic != CacheMagic || header.version != CacheVersion || header.key != key ||
+            header.image_count != images.size())
+            return false;
+
+        uint64_t checksum = Fnv1a(nullptr, 0);
+        for (auto &image : images)
+        {
+            CacheImageHeader image_header;
+            if (!in.read(reinterpret_cast<char *>(&image_header), sizeof(image_header)))
+                return false;
+            if (image_header.w != image.w || image_header.h != image.h || image_header.texel_size != image.texel_size)
+                return false;
+            if (!in.read(static_cast<char *>(image.data), image.bytes))
+                return false;
+            checksum = Fnv1a(&image_header, sizeof(image_header), checksum);
+            checksum = Fnv1a(image.data, image.bytes, checksum);
+        }
+        return checksum == header.checksum;
+    }
+    catch (const std::exception &err)
+    {
+        LOG_ERROR("read ibl cache {} failed: {}", path, err.what());
+        return false;
+    }
+}
+
+// write into a temporary file first so a crash never leaves a half written cache
+void WriteCache(const std::string &path, uint64_t key, const std::vector<CacheImage> &images)
+{
+    if (ibl_cache_dir.empty())
+        return;
+    const auto tmp_path = TempPath(path);
+    try
+    {
+        std::filesystem::create_directories(ibl_cache_dir);
+        {
+            std::ofstream out(tmp_path, std::ios::binary);
+            if (!out.is_open())
+                throw std::runtime_error("open file failed");
+            std::vector<CacheImageHeader> image_headers;
+            uint64_t checksum = Fnv1a(nullptr, 0);
+            for (auto &image : images)
+            {
+                image_headers.push_back({image.w, image.h, image.texel_size, 0});
+                checksum = Fnv1a(&image_headers.back(), sizeof(CacheImageHeader), checksum);
+                checksum = Fnv1a(image.data, image.bytes, checksum);
+            }
+            CacheHeader header{CacheMagic, CacheVersion, key, static_cast<uint32_t>(images.size()), 0, checksum};
+            out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            for (size_t i = 0; i < images.size(); i++)
+            {
+                out.write(reinterpret_cast<const char *>(&image_headers[i]), sizeof(CacheImageHeader));
+                out.write(static_cast<const char *>(images[i].data), images[i].bytes);
+            }
+            if (!out)
+                throw std::runtime_error("write file failed");
+        }
+        std::filesystem::rename(tmp_path, path);
+        LOG_INFO("write ibl cache: {}", path);
+    }
+    catch (const std::exception &err)
+    {
+        LOG_ERROR("write ibl cache {} failed: {}", path, err.what());
+        std::error_code ec;
+        std::filesystem::remove(tmp_path, ec);
+    }
+}
+
+std::vector<CacheImage> EnvironmentImages(const IBL &ibl)
+{
+    std::vector<CacheImage> images;
+    if (!use_sh_irradiance)
+        images.emplace_back(ToCacheImage(ibl.irradiance_map));
+    for (int i = 0; i < ibl.prefilter_map.levels(); i++)
+    {
+        images.emplace_back(ToCacheImage(ibl.prefilter_map.get_level(i)));
+    }
+    return images;
+}
+} // namespace
+
+uint64_t IBLEnvironmentKey(const TextureRGB9E5 &env_mipmap)
+{
+    const int32_t constants[] = {static_cast<int32_t>(CacheVersion), IBL::IrradianceMapSize,
+                                 IBL::PrefilterMapSize, IBL::PrefilterSampleCount, use_sh_irradiance};
+    uint64_t hash = Fnv1a(constants, sizeof(constants));
+    const auto &lod0 = env_mipmap.get_level(0);
+    const int32_t size[] = {lod0.width(), lod0.height()};
+    hash = Fnv1a(size, sizeof(size), hash);
+    return Fnv1a(lod0.data(), lod0.byteSize(), hash);
+}
+
+bool LoadIBLEnvironmentCache(IBL &ibl, uint64_t key)
+{
+    if (!use_sh_irradiance)
+        ibl.irradiance_map = PackedTexture<RGB9E5>(IBL::IrradianceMapSize, IBL::IrradianceMapSize);
+    ibl.prefilter_map.generate(IBL::PrefilterMapSize, IBL::PrefilterMapSize);
+    return ReadCache(CachePath("environment", key), key, EnvironmentImages(ibl));
+}
+
+void SaveIBLEnvironmentCache(const IBL &ibl, uint64_t key)
+{
+    WriteCache(CachePath("environment", key), key, EnvironmentImages(ibl));
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "model.hpp"
+
+// directory of IBL precomputation cache files, empty string disables the cache
+extern std::string ibl_cache_dir;
+
+// irradiance and prefilter map depend on content of environment map lod 0, IBL constants and
+// use_sh_irradiance which leaves irradiance map out of the cache
+uint64_t IBLEnvironmentKey(const TextureRGB9E5 &env_mipmap);
+
+// return false if cache is disabled, missing, stale or broken
+bool LoadIBLEnvironmentCache(IBL &ibl, uint64_t key);
+
+void SaveIBLEnvironmentCache(const IBL &ibl, uint64_t key);
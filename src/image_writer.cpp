@@ -0,0 +1,100 @@
+#include <vector>
+
+#include "image_writer.hpp"
+#include "logger.hpp"
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image_write.h>
+
+ImageWriter::ImageWriter() : busy(false), stop(false)
+{
+    worker = std::thread([this] {
+        while (true)
+        {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(mut);
+                cond.wait(lock, [this] { return stop || !jobs.empty(); });
+                if (stop && jobs.empty())
+                {
+                    return;
+                }
+                job = std::move(jobs.front());
+                jobs.pop();
+                busy = true;
+            }
+            done_cond.notify_all();
+
+            try
+            {
+                encode(job.path, job.pixels);
+            }
+            catch (const std::exception &err)
+            {
+                LOG_ERROR("{}", err.what());
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mut);
+                busy = false;
+            }
+            done_cond.notify_all();
+        }
+    });
+}
+
+ImageWriter::~ImageWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(mut);
+        stop = true;
+    }
+    cond.notify_all();
+    worker.join();
+}
+
+void ImageWriter::write(const std::string &path, const Image<color4b> &pixels)
+{
+    {
+        std::unique_lock<std::mutex> lock(mut);
+        done_cond.wait(lock, [this] { return jobs.size() < MaxPendingCount; });
+        jobs.push(Job{path, pixels});
+    }
+    cond.notify_one();
+}
+
+void ImageWriter::wait()
+{
+    std::unique_lock<std::mutex> lock(mut);
+    done_cond.wait(lock, [this] { return jobs.empty() && !busy; });
+}
+
+void ImageWriter::encode(const std::string &path, const Image<color4b> &pixels)
+{
+    // frame buffer alpha is 0 where nothing is drawn, drop it so output looks like the window
+    const int w = pixels.width();
+    const int h = pixels.height();
+    std::vector<uint8_t> rgb(static_cast<size_t>(w) * h * 3);
+    const auto p = pixels.data();
+    for (int i = 0; i < w * h; i++)
+    {
+        rgb[i * 3 + 0] = p[i].r;
+        rgb[i * 3 + 1] = p[i].g;
+        rgb[i * 3 + 2] = p[i].b;
+    }
+
+    auto pos = path.find_last_of('.');
+    auto ext = pos == std::string::npos ? std::string() : path.substr(pos);
+    int ok;
+    if (ext == ".bmp")
+        ok = stbi_write_bmp(path.c_str(), w, h, 3, rgb.data());
+    else if (ext == ".tga")
+        ok = stbi_write_tga(path.c_str(), w, h, 3, rgb.data());
+    else if (ext == ".jpg")
+        ok = stbi_write_jpg(path.c_str(), w, h, 3, rgb.data(), 95);
+    else
+        ok = stbi_write_png(path.c_str(), w, h, 3, rgb.data(), w * 3);
+    if (!ok)
+        throw std::runtime_error("write image failed: " + path);
+    LOG_INFO("successfully write: {}", path);
+}
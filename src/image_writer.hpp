@@ -0,0 +1,52 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+
+#include "buffer.hpp"
+#include "common.hpp"
+
+/**
+ * @brief encode and write frames on a background thread so that encoding
+ * of one frame overlaps with rendering of the next one.
+ */
+class ImageWriter
+{
+  public:
+    ImageWriter();
+
+    // wait for all pending images to be written
+    ~ImageWriter();
+
+    ImageWriter(const ImageWriter &) = delete;
+
+    ImageWriter &operator=(const ImageWriter &) = delete;
+
+    // copy pixels and queue them, format is chosen by path extension: .png(default) .bmp .tga .jpg
+    // block if MaxPendingCount images are already waiting
+    void write(const std::string &path, const Image<color4b> &pixels);
+
+    void wait();
+
+    static constexpr int MaxPendingCount = 2;
+
+  private:
+    static void encode(const std::string &path, const Image<color4b> &pixels);
+
+    struct Job
+    {
+        std::string path;
+        Image<color4b> pixels;
+    };
+
+    std::thread worker;
+    std::queue<Job> jobs;
+    std::mutex mut;
+    std::condition_variable cond;
+    std::condition_variable done_cond;
+    bool busy;
+    bool stop;
+};
@@ -1,7 +1,9 @@
 #include "input.hpp"
 #include "logger.hpp"
+#include "scene_loader.hpp"
 
-InputProcessor::InputProcessor(const std::shared_ptr<Scene> &scene) : scene(scene)
+InputProcessor::InputProcessor(const std::shared_ptr<Scene> &scene, SceneLoader &scene_loader)
+    : scene(scene), scene_loader(scene_loader)
 {
 
 }
@@ -31,11 +33,10 @@ void InputProcessor::processInput(bool &exit, uint32_t delta_t)
                 auto ext = s.substr(s.find_last_of('.'));
                 if(ext == ".json")
                 {
-                    scene->clearScene();
-                    scene->loadScene(s);
+                    scene_loader.requestScene(s);
                 }
                 else if(ext == ".hdr"){
-                    scene->loadEnvMap(s);
+                    scene_loader.requestEnvMap(s);
                 }
                 else{
                     throw std::runtime_error("invalid input file format");
@@ -10,7 +10,8 @@
 class InputProcessor
 {
   public:
-    explicit InputProcessor(const std::shared_ptr<Scene> &scene);
+    // dropped scene and environment map files are handed to scene loader
+    InputProcessor(const std::shared_ptr<Scene> &scene, SceneLoader &scene_loader);
 
     ~InputProcessor();
 
@@ -18,4 +19,6 @@ class InputProcessor
 
   private:
     RC<Scene> scene;
+
+    SceneLoader &scene_loader;
 };
@@ -2,15 +2,77 @@
 
 #include "engine.hpp"
 #include "logger.hpp"
+#include "mesh.hpp"
 
 extern bool use_hz;
 
+extern bool use_deferred;
+
+extern std::string ibl_cache_dir;
+
+extern bool use_sh_irradiance;
+
+extern bool use_analytic_brdf;
+
+struct HeadlessArgs{
+    bool enable = false;
+    std::string scene_file;
+    std::string camera_path_file;
+    std::string output_dir;
+};
+
+HeadlessArgs headless_args;
+
+struct ConvertMeshArgs{
+    bool enable = false;
+    std::string obj_file;
+    std::string mesh_file;
+};
+
+ConvertMeshArgs convert_mesh_args;
+
 void SetArgv(int argc, char** argv){
     for(int i = 0; i < argc; ++i){
         auto arg = std::string(argv[i]);
+        if(arg == "-headless" && i + 3 < argc){
+            headless_args.enable           = true;
+            headless_args.scene_file       = argv[++i];
+            headless_args.camera_path_file = argv[++i];
+            headless_args.output_dir       = argv[++i];
+            continue;
+        }
+        if(arg == "-ibl-cache" && i + 1 < argc){
+            ibl_cache_dir = argv[++i];
+            continue;
+        }
+        if(arg == "-no-ibl-cache"){
+            ibl_cache_dir.clear();
+            continue;
+        }
+        if(arg == "-no-mesh-cache"){
+            use_mesh_cache = false;
+            continue;
+        }
+        if(arg == "-irradiance-map"){
+            use_sh_irradiance = false;
+            continue;
+        }
+        if(arg == "-analytic-brdf"){
+            use_analytic_brdf = true;
+            continue;
+        }
+        if(arg == "-convert-mesh" && i + 2 < argc){
+            convert_mesh_args.enable    = true;
+            convert_mesh_args.obj_file  = argv[++i];
+            convert_mesh_args.mesh_file = argv[++i];
+            continue;
+        }
         if(arg == "-hz"){
             use_hz = true;
         }
+        if(arg == "-deferred"){
+            use_deferred = true;
+        }
         if(arg == "-debug"){
             SET_LOG_LEVEL_DEBUG
         }
@@ -22,7 +84,10 @@ void SetArgv(int argc, char** argv){
         }
         else{
             SET_LOG_LEVEL_CRITICAL
-            std::cerr<<"params format: [-hz], [-debug] or [-info] or [-error]"<<std::endl;
+            std::cerr<<"params format: [-hz], [-deferred], [-headless scene.json camera_path.json output_dir], "
+                              "[-ibl-cache dir] or [-no-ibl-cache], [-no-mesh-cache], [-irradiance-map], "
+                              "[-analytic-brdf], [-convert-mesh input.obj output.smesh], "
+                              "[-debug] or [-info] or [-error]"<<std::endl;
         }
     }
 }
@@ -37,11 +102,21 @@ int main(int argc, char **argv)
     }
     try
     {
+        if(convert_mesh_args.enable){
+            ConvertObjToMesh(convert_mesh_args.obj_file, convert_mesh_args.mesh_file);
+            return 0;
+        }
+
         auto& engine = Engine::getInstance();
 
-        engine.startup();
+        engine.startup(headless_args.enable);
 
-        engine.run();
+        if(headless_args.enable){
+            engine.runHeadless(headless_args.scene_file, headless_args.camera_path_file, headless_args.output_dir);
+        }
+        else{
+            engine.run();
+        }
 
         engine.shutdown();
     }
@@ -1,4 +1,10 @@
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <limits>
+#include <unordered_map>
 
 #include "mesh.hpp"
 #include "logger.hpp"
@@ -6,8 +12,219 @@
 #define TINYOBJLOADER_IMPLEMENTATION
 #include "tiny_obj_loader.h"
 
-Mesh::Mesh(const std::string &path)
+bool use_mesh_cache = true;
+
+namespace
+{
+// bump it whenever file layout or obj parsing changes
+// 3: triangles and vertices in cluster order, clusters follow the index buffer
+constexpr uint32_t MeshFileVersion = 3;
+constexpr uint32_t MeshFileMagic   = 0x48534d53; // "SMSH"
+constexpr uint64_t MeshFileAlign   = 16;
+
+// vertex streams, index buffer and clusters follow the header at aligned offsets and are used in place after mapping
+struct MeshFileHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    // size and modification time of the obj it was converted from
+    uint64_t source_size;
+    int64_t source_time;
+    // floats of each vertex stream including padding
+    uint32_t stream_stride;
+    uint32_t vertex_count;
+    uint32_t index_count;
+    uint32_t cluster_count;
+    uint64_t stream_offset;
+    uint64_t index_offset;
+    uint64_t cluster_offset;
+    float bound_min[3];
+    float bound_max[3];
+};
+
+struct SourceStamp
+{
+    uint64_t size;
+    int64_t time;
+};
+
+SourceStamp GetSourceStamp(const std::string &path)
+{
+    return {static_cast<uint64_t>(std::filesystem::file_size(path)),
+            static_cast<int64_t>(std::filesystem::last_write_time(path).time_since_epoch().count())};
+}
+
+uint64_t AlignOffset(uint64_t offset)
+{
+    return (offset + MeshFileAlign - 1) / MeshFileAlign * MeshFileAlign;
+}
+
+size_t StreamStride(size_t vertex_count)
+{
+    return (vertex_count + Mesh::StreamAlign - 1) / Mesh::StreamAlign * Mesh::StreamAlign;
+}
+
+std::string MeshCachePath(const std::string &obj_path)
+{
+    return std::filesystem::path(obj_path).replace_extension(".smesh").string();
+}
+
+// obj indexes position, normal and texcoord separately so a vertex is identified by all three
+struct ObjIndexKey
+{
+    int vertex_index;
+    int normal_index;
+    int texcoord_index;
+
+    bool operator==(const ObjIndexKey &other) const
+    {
+        return vertex_index == other.vertex_index && normal_index == other.normal_index &&
+               texcoord_index == other.texcoord_index;
+    }
+};
+
+struct ObjIndexKeyHash
+{
+    size_t operator()(const ObjIndexKey &key) const
+    {
+        return (static_cast<size_t>(key.vertex_index) * 73856093u) ^
+               (static_cast<size_t>(key.normal_index) * 19349663u) ^
+               (static_cast<size_t>(key.texcoord_index) * 83492791u);
+    }
+};
+// median split of triangle centroids along the longest axis until a node has no more than
+// Mesh::ClusterTriangleCount triangles, leaves of this BVH in order are the clusters
+void SplitClusters(std::vector<uint32_t> &order, const std::vector<float3> &centroids, size_t beg, size_t end,
+                   std::vector<std::pair<size_t, size_t>> &leaves)
+{
+    if (end - beg <= Mesh::ClusterTriangleCount)
+    {
+        leaves.emplace_back(beg, end);
+        return;
+    }
+    float3 lo(std::numeric_limits<float>::max());
+    float3 hi(std::numeric_limits<float>::lowest());
+    for (size_t i = beg; i < end; i++)
+    {
+        lo = min(lo, centroids[order[i]]);
+        hi = max(hi, centroids[order[i]]);
+    }
+    const float3 extent = hi - lo;
+    const int axis = (extent.x >= extent.y && extent.x >= extent.z) ? 0 : (extent.y >= extent.z ? 1 : 2);
+    const size_t mid = beg + (end - beg) / 2;
+    std::nth_element(order.begin() + beg, order.begin() + mid, order.begin() + end,
+                     [&](uint32_t a, uint32_t b) { return centroids[a][axis] < centroids[b][axis]; });
+    SplitClusters(order, centroids, beg, mid, leaves);
+    SplitClusters(order, centroids, mid, end, leaves);
+}
+
+// box, vertex range and normal cone of triangles [beg, end)
+Mesh::Cluster BoundCluster(const std::vector<Mesh::Vertex> &vertices, const std::vector<uint32_t> &indices,
+                           size_t beg, size_t end)
+{
+    Mesh::Cluster cluster{};
+    cluster.box.min_p = float3(std::numeric_limits<float>::max());
+    cluster.box.max_p = float3(std::numeric_limits<float>::lowest());
+    cluster.first_triangle = static_cast<uint32_t>(beg);
+    cluster.triangle_count = static_cast<uint32_t>(end - beg);
+    cluster.vertex_begin = std::numeric_limits<uint32_t>::max();
+    cluster.vertex_end = 0;
+
+    // counter clockwise triangles face the eye, degenerate ones are always culled and do not widen the cone
+    std::vector<float3> normals;
+    float3 normal_sum(0.f);
+    for (size_t t = beg; t < end; t++)
+    {
+        float3 p[3];
+        for (int k = 0; k < 3; k++)
+        {
+            const uint32_t index = indices[t * 3 + k];
+            p[k] = vertices[index].pos;
+            cluster.box.min_p = min(cluster.box.min_p, p[k]);
+            cluster.box.max_p = max(cluster.box.max_p, p[k]);
+            cluster.vertex_begin = std::min(cluster.vertex_begin, index);
+            cluster.vertex_end = std::max(cluster.vertex_end, index + 1);
+        }
+        const float3 n = cross(p[1] - p[0], p[2] - p[0]);
+        const float area = length(n);
+        if (area > 0.f)
+        {
+            normals.emplace_back(n / area);
+            normal_sum += normals.back();
+        }
+    }
+
+    cluster.cone_axis = {0.f, 0.f, 1.f};
+    cluster.cone_cutoff = 1.f;
+    const float sum_length = length(normal_sum);
+    if (sum_length > 0.f)
+    {
+        const float3 axis = normal_sum / sum_length;
+        float min_dot = 1.f;
+        for (const auto &n : normals)
+            min_dot = std::min(min_dot, dot(n, axis));
+        // a cone wider than about 84 degrees is left as never facing away
+        if (min_dot > 0.1f)
+        {
+            cluster.cone_axis = axis;
+            cluster.cone_cutoff = std::sqrt(1.f - min_dot * min_dot);
+        }
+    }
+    return cluster;
+}
+
+// reorder triangles into clusters and vertices by first use, so the vertices of a cluster are a short range
+std::vector<Mesh::Cluster> BuildClusters(std::vector<Mesh::Vertex> &vertices, std::vector<uint32_t> &indices)
+{
+    const size_t triangle_count = indices.size() / 3;
+    std::vector<float3> centroids(triangle_count);
+    for (size_t t = 0; t < triangle_count; t++)
+    {
+        centroids[t] = (vertices[indices[t * 3]].pos + vertices[indices[t * 3 + 1]].pos +
+                        vertices[indices[t * 3 + 2]].pos) *
+                       (1.f / 3.f);
+    }
+    std::vector<uint32_t> order(triangle_count);
+    for (size_t t = 0; t < triangle_count; t++)
+        order[t] = static_cast<uint32_t>(t);
+    std::vector<std::pair<size_t, size_t>> leaves;
+    if (triangle_count > 0)
+        SplitClusters(order, centroids, 0, triangle_count, leaves);
+
+    // vertices no triangle references are dropped
+    constexpr uint32_t Unused = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> remap(vertices.size(), Unused);
+    std::vector<Mesh::Vertex> sorted_vertices;
+    sorted_vertices.reserve(vertices.size());
+    std::vector<uint32_t> sorted_indices(indices.size());
+    for (size_t t = 0; t < triangle_count; t++)
+    {
+        for (int k = 0; k < 3; k++)
+        {
+            const uint32_t index = indices[order[t] * 3 + k];
+            if (remap[index] == Unused)
+            {
+                remap[index] = static_cast<uint32_t>(sorted_vertices.size());
+                sorted_vertices.emplace_back(vertices[index]);
+            }
+            sorted_indices[t * 3 + k] = remap[index];
+        }
+    }
+    vertices = std::move(sorted_vertices);
+    indices = std::move(sorted_indices);
+
+    std::vector<Mesh::Cluster> clusters;
+    clusters.reserve(leaves.size());
+    for (const auto &leaf : leaves)
+        clusters.emplace_back(BoundCluster(vertices, indices, leaf.first, leaf.second));
+    return clusters;
+}
+
+Mesh ParseObj(const std::string &path)
 {
+    std::vector<Mesh::Vertex> vertices;
+    std::vector<uint32_t> indices;
+
     tinyobj::ObjReader reader;
     if (!reader.ParseFromFile(path))
     {
@@ -17,6 +234,8 @@ Mesh::Mesh(const std::string &path)
     auto &attrib = reader.GetAttrib();
     auto &shapes = reader.GetShapes();
 
+    std::unordered_map<ObjIndexKey, uint32_t, ObjIndexKeyHash> vertex_map;
+
     for (auto &shape : shapes)
     {
         for (auto face_vertex_count : shape.mesh.num_face_vertices)
@@ -36,25 +255,239 @@ Mesh::Mesh(const std::string &path)
 
         LOG_INFO("shape ({}) triangle count: {}, vertex count: {}",shape.name,triangle_count,vertex_count);
 
-        for (size_t i = 0; i < triangle_count; i++)
+        indices.reserve(indices.size() + shape.mesh.indices.size());
+        for (auto index : shape.mesh.indices)
         {
-            Triangle triangle{};
-            for (int k = 0; k < 3; k++)
+            ObjIndexKey key{index.vertex_index, index.normal_index, index.texcoord_index};
+            auto it = vertex_map.find(key);
+            if (it != vertex_map.end())
             {
-                auto index = shape.mesh.indices[i * 3 + k];
-                triangle.vertices[k].pos = {attrib.vertices[3 * index.vertex_index + 0],
-                                            attrib.vertices[3 * index.vertex_index + 1],
-                                            attrib.vertices[3 * index.vertex_index + 2]};
-
-                triangle.vertices[k].normal = {attrib.normals[3 * index.normal_index + 0],
-                                               attrib.normals[3 * index.normal_index + 1],
-                                               attrib.normals[3 * index.normal_index + 2]};
+                indices.emplace_back(it->second);
+                continue;
+            }
 
-                triangle.vertices[k].tex_coord = {attrib.texcoords[2 * index.texcoord_index + 0],
-                                                  attrib.texcoords[2 * index.texcoord_index + 1]};
+            Mesh::Vertex vertex{};
+            vertex.pos = {attrib.vertices[3 * index.vertex_index + 0],
+                          attrib.vertices[3 * index.vertex_index + 1],
+                          attrib.vertices[3 * index.vertex_index + 2]};
+            if (index.normal_index >= 0)
+            {
+                vertex.normal = {attrib.normals[3 * index.normal_index + 0],
+                                 attrib.normals[3 * index.normal_index + 1],
+                                 attrib.normals[3 * index.normal_index + 2]};
             }
-            this->triangles.emplace_back(triangle);
+            if (index.texcoord_index >= 0)
+            {
+                vertex.tex_coord = {attrib.texcoords[2 * index.texcoord_index + 0],
+                                    attrib.texcoords[2 * index.texcoord_index + 1]};
+            }
+            auto vertex_id = static_cast<uint32_t>(vertices.size());
+            vertices.emplace_back(vertex);
+            vertex_map.emplace(key, vertex_id);
+            indices.emplace_back(vertex_id);
         }
     }
+    LOG_INFO("mesh unique vertex count: {}, triangle count: {}",vertices.size(),indices.size() / 3);
     LOG_INFO("successfully load: {}",path);
+    return Mesh(std::move(vertices), std::move(indices));
+}
+
+// write into a temporary file first so a crash never leaves a half written mesh
+void WriteMeshFile(const std::string &path, const Mesh &mesh, const SourceStamp &source)
+{
+    const auto indices = mesh.indices();
+    const auto clusters = mesh.clusters();
+    const auto &box = mesh.getBoundBox();
+    const size_t stream_stride = StreamStride(mesh.vertexCount());
+    const size_t stream_bytes = sizeof(float) * Mesh::VertexStreamCount * stream_stride;
+
+    MeshFileHeader header{};
+    header.magic = MeshFileMagic;
+    header.version = MeshFileVersion;
+    header.source_size = source.size;
+    header.source_time = source.time;
+    header.stream_stride = static_cast<uint32_t>(stream_stride);
+    header.vertex_count = static_cast<uint32_t>(mesh.vertexCount());
+    header.index_count = static_cast<uint32_t>(indices.size());
+    header.cluster_count = static_cast<uint32_t>(clusters.size());
+    header.stream_offset = AlignOffset(sizeof(header));
+    header.index_offset = AlignOffset(header.stream_offset + stream_bytes);
+    header.cluster_offset = AlignOffset(header.index_offset + sizeof(uint32_t) * indices.size());
+    for (int i = 0; i < 3; i++)
+    {
+        header.bound_min[i] = box.min_p[i];
+        header.bound_max[i] = box.max_p[i];
+    }
+
+    auto tmp_path = path + ".tmp";
+    {
+        std::ofstream out(tmp_path, std::ios::binary);
+        if (!out.is_open())
+            throw std::runtime_error("open file failed");
+        const std::vector<char> zeros(std::max<size_t>(MeshFileAlign, sizeof(float) * Mesh::StreamAlign));
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        out.write(zeros.data(), header.stream_offset - sizeof(header));
+        for (int s = 0; s < Mesh::VertexStreamCount; s++)
+        {
+            out.write(reinterpret_cast<const char *>(mesh.stream(static_cast<Mesh::VertexStream>(s))),
+                      sizeof(float) * mesh.vertexCount());
+            out.write(zeros.data(), sizeof(float) * (stream_stride - mesh.vertexCount()));
+        }
+        out.write(zeros.data(), header.index_offset - header.stream_offset - stream_bytes);
+        out.write(reinterpret_cast<const char *>(indices.data()), sizeof(uint32_t) * indices.size());
+        out.write(zeros.data(), header.cluster_offset - header.index_offset - sizeof(uint32_t) * indices.size());
+        out.write(reinterpret_cast<const char *>(clusters.data()), sizeof(Mesh::Cluster) * clusters.size());
+        if (!out)
+            throw std::runtime_error("write file failed");
+    }
+    std::filesystem::rename(tmp_path, path);
+    LOG_INFO("write mesh file: {}", path);
+}
+
+// clusters of a mapped file must cover all triangles in order and every index must lie in the vertex range of its
+// cluster, as they are used in place for vertex jobs and triangle assembly without bound checks
+bool ValidateClusters(const Mesh::Cluster *clusters, size_t cluster_count, const uint32_t *indices,
+                      size_t index_count, size_t vertex_count)
+{
+    size_t next_triangle = 0;
+    for (size_t c = 0; c < cluster_count; c++)
+    {
+        const auto &cluster = clusters[c];
+        if (cluster.first_triangle != next_triangle || cluster.triangle_count > index_count / 3 - next_triangle ||
+            cluster.vertex_begin > cluster.vertex_end || cluster.vertex_end > vertex_count)
+            return false;
+        const auto beg = indices + static_cast<size_t>(cluster.first_triangle) * 3;
+        const auto end = beg + static_cast<size_t>(cluster.triangle_count) * 3;
+        if (std::any_of(beg, end, [&](uint32_t index) {
+                return index < cluster.vertex_begin || index >= cluster.vertex_end;
+            }))
+            return false;
+        next_triangle += cluster.triangle_count;
+    }
+    return next_triangle == index_count / 3;
+}
+} // namespace
+
+Mesh::Mesh(const std::string &path)
+{
+    if (std::filesystem::path(path).extension() == ".smesh")
+    {
+        if (!mapFile(path, ""))
+            throw std::runtime_error("invalid mesh file: " + path);
+        return;
+    }
+
+    const auto cache_path = MeshCachePath(path);
+    if (use_mesh_cache && std::filesystem::exists(cache_path))
+    {
+        try
+        {
+            if (mapFile(cache_path, path))
+                return;
+            LOG_INFO("mesh cache {} is stale or invalid", cache_path);
+        }
+        catch (const std::exception &err)
+        {
+            LOG_ERROR("read mesh cache {} failed: {}", cache_path, err.what());
+        }
+    }
+
+    *this = ParseObj(path);
+
+    if (use_mesh_cache)
+    {
+        try
+        {
+            WriteMeshFile(cache_path, *this, GetSourceStamp(path));
+        }
+        catch (const std::exception &err)
+        {
+            LOG_ERROR("write mesh cache {} failed: {}", cache_path, err.what());
+        }
+    }
+}
+
+Mesh::Mesh(std::vector<Vertex> vertices, std::vector<uint32_t> indices)
+{
+    cluster_storage = BuildClusters(vertices, indices);
+    cluster_view = {cluster_storage.data(), cluster_storage.size()};
+    index_storage = std::move(indices);
+    index_view = {index_storage.data(), index_storage.size()};
+    stream_stride = StreamStride(vertices.size());
+    vertex_count = vertices.size();
+    stream_storage.resize(VertexStreamCount * stream_stride);
+    stream_data = stream_storage.data();
+    for (size_t i = 0; i < vertex_count; i++)
+    {
+        const auto &v = vertices[i];
+        const float components[VertexStreamCount] = {v.pos.x,    v.pos.y,    v.pos.z,         v.normal.x,
+                                                     v.normal.y, v.normal.z, v.tex_coord.x, v.tex_coord.y};
+        for (int s = 0; s < VertexStreamCount; s++)
+            stream_storage[s * stream_stride + i] = components[s];
+    }
+    computeBoundBox();
+}
+
+void Mesh::computeBoundBox()
+{
+    bound_box.min_p = float3(std::numeric_limits<float>::max());
+    bound_box.max_p = float3(std::numeric_limits<float>::lowest());
+    for (size_t i = 0; i < vertex_count; i++)
+    {
+        bound_box.min_p = min(bound_box.min_p, position(i));
+        bound_box.max_p = max(bound_box.max_p, position(i));
+    }
+}
+
+// streams are referenced in place, only the header, indices and clusters are read here to validate the file
+bool Mesh::mapFile(const std::string &path, const std::string &source_path)
+{
+    auto mapped = newBox<MappedFile>(path);
+
+    MeshFileHeader header;
+    if (mapped->size() < sizeof(header))
+        return false;
+    std::memcpy(&header, mapped->data(), sizeof(header));
+    if (header.magic != MeshFileMagic || header.version != MeshFileVersion ||
+        header.stream_stride != StreamStride(header.vertex_count))
+        return false;
+    if (!source_path.empty())
+    {
+        auto source = GetSourceStamp(source_path);
+        if (header.source_size != source.size || header.source_time != source.time)
+            return false;
+    }
+    if (header.index_count % 3 != 0 || header.stream_offset % MeshFileAlign != 0 ||
+        header.index_offset % MeshFileAlign != 0 ||
+        header.stream_offset + sizeof(float) * VertexStreamCount * header.stream_stride > mapped->size() ||
+        header.index_offset + sizeof(uint32_t) * header.index_count > mapped->size() ||
+        header.cluster_offset % MeshFileAlign != 0 ||
+        header.cluster_offset + sizeof(Cluster) * header.cluster_count > mapped->size())
+        return false;
+    // covering all triangles by clusters within vertex_count also bounds every index by vertex_count
+    const auto indices = reinterpret_cast<const uint32_t *>(mapped->data() + header.index_offset);
+    const auto clusters = reinterpret_cast<const Cluster *>(mapped->data() + header.cluster_offset);
+    if (!ValidateClusters(clusters, header.cluster_count, indices, header.index_count, header.vertex_count))
+        return false;
+
+    stream_storage.clear();
+    index_storage.clear();
+    cluster_storage.clear();
+    stream_data = reinterpret_cast<const float *>(mapped->data() + header.stream_offset);
+    stream_stride = header.stream_stride;
+    vertex_count = header.vertex_count;
+    index_view = {indices, header.index_count};
+    cluster_view = {clusters, header.cluster_count};
+    bound_box.min_p = {header.bound_min[0], header.bound_min[1], header.bound_min[2]};
+    bound_box.max_p = {header.bound_max[0], header.bound_max[1], header.bound_max[2]};
+    file = std::move(mapped);
+
+    LOG_INFO("mesh vertex count: {}, triangle count: {}", vertex_count, triangleCount());
+    LOG_INFO("successfully map: {}", path);
+    return true;
+}
+
+void ConvertObjToMesh(const std::string &obj_path, const std::string &mesh_path)
+{
+    WriteMeshFile(mesh_path, ParseObj(obj_path), GetSourceStamp(obj_path));
 }
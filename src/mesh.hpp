@@ -1,9 +1,12 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
 #include "common.hpp"
+#include "geometry.hpp"
+#include "mapped_file.hpp"
 
 struct Triangle
 {
@@ -29,11 +32,173 @@ struct Triangle
     }
 };
 
+// read only view of a contiguous array owned by someone else
+template <typename T>
+class ArrayView
+{
+  public:
+    ArrayView() = default;
+
+    ArrayView(const T *ptr, size_t count) : ptr(ptr), count(count)
+    {
+    }
+
+    const T &operator[](size_t i) const
+    {
+        return ptr[i];
+    }
+
+    const T *data() const
+    {
+        return ptr;
+    }
+
+    size_t size() const
+    {
+        return count;
+    }
+
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    const T *begin() const
+    {
+        return ptr;
+    }
+
+    const T *end() const
+    {
+        return ptr + count;
+    }
+
+  private:
+    const T *ptr = nullptr;
+    size_t count = 0;
+};
+
 struct Mesh
 {
+    // vertex at rest, Triangle::Vertex is the one after vertex shader
+    struct Vertex
+    {
+        float3 pos;
+        float3 normal;
+        float2 tex_coord;
+    };
+
+    // vertices are stored as one float stream per component so vertex shading loads 4 vertices at once
+    enum VertexStream
+    {
+        PositionX,
+        PositionY,
+        PositionZ,
+        NormalX,
+        NormalY,
+        NormalZ,
+        TexCoordU,
+        TexCoordV,
+        VertexStreamCount
+    };
+
+    // streams are padded to a multiple of it with zeros
+    static constexpr size_t StreamAlign = 8;
+
+    // triangles are sorted into spatially coherent clusters of ClusterTriangleCount / 2 to ClusterTriangleCount
+    // triangles when a mesh is built, so a draw can drop the ones outside the frustum or facing away before
+    // shading their vertices
+    static constexpr uint32_t ClusterTriangleCount = 128;
+
+    struct Cluster
+    {
+        BoundBox3D box;
+        // normals of its triangles are all within the cone around axis, cutoff is sine of the widest angle
+        // between them and axis, or 1 if the cone is too wide to ever face away
+        float3 cone_axis;
+        float cone_cutoff;
+        uint32_t first_triangle;
+        uint32_t triangle_count;
+        // vertices its triangles reference are in [vertex_begin, vertex_end)
+        uint32_t vertex_begin;
+        uint32_t vertex_end;
+    };
+
     Mesh() = default;
 
+    // .smesh is mapped directly, any other file is parsed as obj through a .smesh cache next to it
     explicit Mesh(const std::string &path);
 
-    std::vector<Triangle> triangles;
-};
\ No newline at end of file
+    // triangles and vertices are reordered so clusters are contiguous ranges of both
+    Mesh(std::vector<Vertex> vertices, std::vector<uint32_t> indices);
+
+    // views point into owned storage or mapped file which are both kept by move
+    Mesh(Mesh &&) = default;
+
+    Mesh &operator=(Mesh &&) = default;
+
+    Mesh(const Mesh &) = delete;
+
+    Mesh &operator=(const Mesh &) = delete;
+
+    size_t triangleCount() const
+    {
+        return index_view.size() / 3;
+    }
+
+    size_t vertexCount() const
+    {
+        return vertex_count;
+    }
+
+    // component of deduplicated vertices which are referenced by three indices for each triangle
+    const float *stream(VertexStream s) const
+    {
+        return stream_data + s * stream_stride;
+    }
+
+    float3 position(size_t i) const
+    {
+        return {stream(PositionX)[i], stream(PositionY)[i], stream(PositionZ)[i]};
+    }
+
+    ArrayView<uint32_t> indices() const
+    {
+        return index_view;
+    }
+
+    // clusters covering all triangles in order
+    ArrayView<Cluster> clusters() const
+    {
+        return cluster_view;
+    }
+
+    const BoundBox3D &getBoundBox() const
+    {
+        return bound_box;
+    }
+
+  private:
+    void computeBoundBox();
+
+    // map a .smesh file, false if it is invalid or not converted from source_path as it is now
+    bool mapFile(const std::string &path, const std::string &source_path);
+
+    std::vector<float> stream_storage;
+    std::vector<uint32_t> index_storage;
+    std::vector<Cluster> cluster_storage;
+    Box<MappedFile> file;
+
+    const float *stream_data = nullptr;
+    size_t stream_stride = 0;
+    size_t vertex_count = 0;
+    ArrayView<uint32_t> index_view;
+    ArrayView<Cluster> cluster_view;
+    BoundBox3D bound_box{};
+};
+
+// whether obj meshes are loaded through .smesh cache files
+extern bool use_mesh_cache;
+
+// parse obj into a mesh and write it as a .smesh file which can be mapped by Mesh(path)
+void ConvertObjToMesh(const std::string &obj_path, const std::string &mesh_path);
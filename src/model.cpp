@@ -1,152 +1,68 @@
 #include "model.hpp"
+#include "asset_manager.hpp"
+#include "ibl_cache.hpp"
+#include "mapped_file.hpp"
 #include "parallel.hpp"
+#include "radiance_hdr.hpp"
 #include "logger.hpp"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 
 namespace{
-    auto LoadRGBImage(const std::string &path)
+    // material textures are loaded with their whole mip chain
+    template <typename Format>
+    PackedMipMap<Format> LoadTexture(const std::string &path)
     {
-        stbi_set_flip_vertically_on_load(true);
+        stbi_set_flip_vertically_on_load_thread(true);
         int width, height, channels;
-        auto data = stbi_load(path.c_str(), &width, &height, &channels, 0);
-        assert(channels == 3);
+        // image loader converts whatever channels the file has to what the format expects
+        auto data = stbi_load(path.c_str(), &width, &height, &channels, Format::Channels);
         if (!data)
-            throw std::runtime_error("load rgb image failed");
-        Texture<float3> t(width, height);
-        constexpr float inv = 1.f / 255.f;
-        for (int x = 0; x < width; x++)
-        {
-            for (int y = 0; y < height; y++)
-            {
-                t(x, y) = float3{static_cast<float>(data[(y * width + x) * channels + 0]) * inv,
-                                 static_cast<float>(data[(y * width + x) * channels + 1]) * inv,
-                                 static_cast<float>(data[(y * width + x) * channels + 2]) * inv};
-            }
-        }
+            throw std::runtime_error("load texture failed: " + path);
+        PackedTexture<Format> t(width, height, data);
         stbi_image_free(data);
         LOG_INFO("successfully load: {}",path);
-        return t;
+        return PackedMipMap<Format>(std::move(t));
     }
-    auto LoadSRGBImage(const std::string &path)
-    {
-        stbi_set_flip_vertically_on_load(true);
-        int width, height, channels;
-        auto data = stbi_load(path.c_str(), &width, &height, &channels, 0);
-        assert(channels == 3);
-        if (!data)
-            throw std::runtime_error("load srgb image failed");
-        Texture<float3> t(width, height);
-        constexpr float inv = 1.f / 255.f;
-        for (int x = 0; x < width; x++)
-        {
-            for (int y = 0; y < height; y++)
-            {
-                t(x, y) = float3{std::pow(static_cast<float>(data[(y * width + x) * channels + 0]) * inv, 2.2f),
-                                 std::pow(static_cast<float>(data[(y * width + x) * channels + 1]) * inv, 2.2f),
-                                 std::pow(static_cast<float>(data[(y * width + x) * channels + 2]) * inv, 2.2f)};
-            }
-        }
-        stbi_image_free(data);
-        LOG_INFO("successfully load: {}",path);
-        return t;
-    }
-    auto LoadXYZImage(const std::string &path)
-    {
-        stbi_set_flip_vertically_on_load(true);
-        int width, height, channels;
-        auto data = stbi_load(path.c_str(), &width, &height, &channels, 0);
-        assert(channels == 3);
-        if (!data)
-            throw std::runtime_error("load xyz image failed");
-        Texture<float3> t(width, height);
-        constexpr float inv = 2.f / 255.f;
-        for (int x = 0; x < width; x++)
-        {
-            for (int y = 0; y < height; y++)
-            {
-                t(x, y) = float3{static_cast<float>(data[(y * width + x) * channels + 0]) * inv - 1.f,
-                                 static_cast<float>(data[(y * width + x) * channels + 1]) * inv - 1.f,
-                                 static_cast<float>(data[(y * width + x) * channels + 2]) * inv - 1.f};
-            }
-        }
-        stbi_image_free(data);
-        LOG_INFO("successfully load: {}",path);
-        return t;
-    }
-    auto LoadRImage(const std::string &path)
+
+    Image2D<float3> LoadHDR(const std::string &path)
     {
-        stbi_set_flip_vertically_on_load(true);
-        int width, height, channels;
-        auto data = stbi_load(path.c_str(), &width, &height, &channels, 0);
-        assert(channels == 1);
-        if (!data)
-            throw std::runtime_error("load r image failed");
-        Texture<float> t(width, height);
-        constexpr float inv = 1.f / 255.f;
-        for (int x = 0; x < width; x++)
+        // radiance files are decoded from the mapped file straight into the image
         {
-            for (int y = 0; y < height; y++)
+            MappedFile file(path);
+            if (IsRadianceHDR(file.data(), file.size()))
             {
-                t(x, y) = static_cast<float>(data[(y * width + x) * channels + 0]) * inv;
+                auto image = DecodeRadianceHDR(file.data(), file.size());
+                LOG_INFO("successfully load: {}",path);
+                return image;
             }
         }
-        stbi_image_free(data);
-        LOG_INFO("successfully load: {}",path);
-        return t;
-    }
-
-    auto LoadSRImage(const std::string &path)
-    {
-        stbi_set_flip_vertically_on_load(true);
-        int width, height, channels;
-        auto data = stbi_load(path.c_str(), &width, &height, &channels, 0);
-        assert(channels == 1);
-        if (!data)
-            throw std::runtime_error("load r image failed");
-        Texture<float> t(width, height);
-        constexpr float inv = 1.f / 255.f;
-        for (int x = 0; x < width; x++)
+        stbi_set_flip_vertically_on_load_thread(false);
+        int w, h, nComp;
+        auto d = stbi_loadf(path.c_str(), &w, &h, &nComp, 3);
+        if (!d)
         {
-            for (int y = 0; y < height; y++)
-            {
-                t(x, y) = std::pow(static_cast<float>(data[(y * width + x) * channels + 0]) * inv, 2.2f);
-            }
+            throw std::runtime_error("load image failed: " + path);
         }
-        stbi_image_free(data);
+        Image2D<float3> image(w, h, reinterpret_cast<float3 *>(d));
+        stbi_image_free(d);
         LOG_INFO("successfully load: {}",path);
-        return t;
+        return image;
     }
 
-    auto LoadHDR(const std::string &path)
+    // resample equirectangular env into size x size octahedral map
+    PackedTexture<RGB9E5> CreateOctahedralMap(const Image2D<float3> &env, int size)
     {
-        stbi_set_flip_vertically_on_load(false);
-        int w, h, nComp;
-        auto d = stbi_loadf(path.c_str(), &w, &h, &nComp, 0);
-        if (!d)
-        {
-            throw std::runtime_error("load image failed");
-        }
-        if (nComp == 3)
-        {
-            return Image2D<float3>(w, h, reinterpret_cast<float3 *>(d));
-        }
-        else if (nComp == 4)
-        {
-            Image2D<float3> image(w, h);
-            auto p = image.data();
-            for (int i = 0; i < w * h; ++i)
+        PackedTexture<RGB9E5> map(size, size);
+        parallel_for(0, size, [&](int y) {
+            for (int x = 0; x < size; ++x)
             {
-                p[i] = {d[i * 3], d[i * 3 + 1], d[i * 3 + 2]};
+                auto uv = sampleSphericalMap(octahedralTexelDirection(x, y, size));
+                map.texel(x, y) = RGB9E5::encode(LinearSampler::sample2D(env, uv.x, uv.y));
             }
-            return image;
-        }
-        else
-        {
-            throw std::runtime_error("invalid image component");
-        }
-        LOG_INFO("successfully load: {}",path);
+        });
+        return map;
     }
 }
 
@@ -160,29 +76,29 @@ mat4 Model::getModelMatrix() const
     return model_matrix;
 }
 
-const Texture<float3> *Model::getAlbedoMap() const
+const TextureRGBA8 *Model::getAlbedoMap() const
 {
-    return &albedo;
+    return albedo.get();
 }
 
-const Texture<float3> *Model::getNormalMap() const
+const TextureRG8 *Model::getNormalMap() const
 {
-    return &normal;
+    return normal.get();
 }
 
-const Texture<float> *Model::getAOMap() const
+const TextureR8 *Model::getAOMap() const
 {
-    return &ambientO;
+    return ambientO.get();
 }
 
-const Texture<float> *Model::getRoughnessMap() const
+const TextureR8 *Model::getRoughnessMap() const
 {
-    return &roughness;
+    return roughness.get();
 }
 
-const Texture<float> *Model::getMetallicMap() const
+const TextureR8 *Model::getMetallicMap() const
 {
-    return &metallic;
+    return metallic.get();
 }
 
 Model::Model(Model &&rhs) noexcept
@@ -210,49 +126,39 @@ void Model::loadModelMatrix(ModelTransform desc)
 
 void Model::loadMesh(const std::string &mesh_path)
 {
-    this->mesh = std::make_unique<Mesh>(mesh_path);
-    box.min_p = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
-                 std::numeric_limits<float>::max()};
-    box.max_p = {-std::numeric_limits<float>::min(), -std::numeric_limits<float>::min(),
-                 -std::numeric_limits<float>::min()};
-    for (auto &tri : mesh->triangles)
-    {
-        for (auto &v : tri.vertices)
-        {
-            box.min_p.x = std::min(box.min_p.x, v.pos.x);
-            box.min_p.y = std::min(box.min_p.y, v.pos.y);
-            box.min_p.z = std::min(box.min_p.z, v.pos.z);
-            box.max_p.x = std::max(box.max_p.x, v.pos.x);
-            box.max_p.y = std::max(box.max_p.y, v.pos.y);
-            box.max_p.z = std::max(box.max_p.z, v.pos.z);
-        }
-    }
+    this->mesh = AssetManager::getInstance().load<Mesh>(mesh_path, [&] { return Mesh(mesh_path); });
+    box = mesh->getBoundBox();
     LOG_INFO("mesh boundary: ({},{},{}) ~ ({},{},{})",box.min_p.x,box.min_p.y,box.min_p.z,box.max_p.x,box.max_p.y,box.max_p.z);
 }
 
 void Model::loadAlbedoMap(const std::string &albedo_path)
 {
-    this->albedo = LoadSRGBImage(albedo_path);
+    this->albedo = AssetManager::getInstance().load<TextureRGBA8>(
+        albedo_path, [&] { return LoadTexture<RGBA8_SRGB>(albedo_path); });
 }
 
 void Model::loadNormalMap(const std::string &normal_path)
 {
-    this->normal = LoadXYZImage(normal_path);
+    this->normal = AssetManager::getInstance().load<TextureRG8>(
+        normal_path, [&] { return LoadTexture<RG8_Normal>(normal_path); });
 }
 
 void Model::loadAOMap(const std::string &ambient_path)
 {
-    this->ambientO = LoadRImage(ambient_path);
+    this->ambientO = AssetManager::getInstance().load<TextureR8>(
+        ambient_path, [&] { return LoadTexture<R8>(ambient_path); });
 }
 
 void Model::loadRoughnessMap(const std::string &roughness_path)
 {
-    this->roughness = LoadRImage(roughness_path);
+    this->roughness = AssetManager::getInstance().load<TextureR8>(
+        roughness_path, [&] { return LoadTexture<R8>(roughness_path); });
 }
 
 void Model::loadMetallicMap(const std::string &metallic_path)
 {
-    this->metallic = LoadRImage(metallic_path);
+    this->metallic = AssetManager::getInstance().load<TextureR8>(
+        metallic_path, [&] { return LoadTexture<R8>(metallic_path); });
 }
 
 const BoundBox3D &Model::getBoundBox() const
@@ -263,16 +169,23 @@ const BoundBox3D &Model::getBoundBox() const
 void Model::loadEnvironmentMap(const std::string& path){
 
     auto hdr = LoadHDR(path);
-    this->env_mipmap = std::make_shared<MipMap2D<float3>>();
-    this->env_mipmap->generate(hdr);
+    // equirectangular map is only read here, sky and IBL precompute use its octahedral chain,
+    // a map of height x height has no fewer texels on its equator than the equirectangular one
+    this->env_mipmap = std::make_shared<TextureRGB9E5>();
+    this->env_mipmap->generate(CreateOctahedralMap(hdr, std::max(2, hdr.height())));
     LOG_INFO("load and generate environment map successfully");
 }
 
-const std::shared_ptr<MipMap2D<float3>>& Model::getEnvironmentMap() const
+const std::shared_ptr<TextureRGB9E5>& Model::getEnvironmentMap() const
 {
     return env_mipmap;
 }
 
+const PackedTexture<RGB9E5>& Model::getSkyMap() const
+{
+    return env_mipmap->get_level(0);
+}
+
 namespace {
     float RadicalInverse_Vdc(uint32_t bits)
     {
@@ -303,7 +216,8 @@ namespace {
         return nom / denom;
     }
 
-    float3 ImportanceSampleGGX(const float2 &Xi, const float3 &N, float roughness)
+    // half vector around N = (0,0,1)
+    float3 ImportanceSampleGGXLocal(const float2 &Xi, float roughness)
     {
         float a = roughness * roughness;
 
@@ -315,13 +229,7 @@ namespace {
         H.x = cos(phi) * sinTheta;
         H.y = sin(phi) * sinTheta;
         H.z = cosTheta;
-
-        float3 s, t;
-        coordinate(N, s, t);
-
-        // transform from local to world
-        float3 sample_vec = H.x * s + H.y * t + H.z * N;
-        return normalize(sample_vec);
+        return H;
     }
 
     float GeometrySchlickGGX(float NdotV, float roughness)
@@ -348,19 +256,16 @@ namespace {
     }
 }
 
-void createIBLResource(IBL& ibl,const MipMap2D<float3>& env_mipmap)
+static void createIrradianceMap(IBL& ibl,const TextureRGB9E5& env_mipmap)
 {
-    static float3 world_up = float3(0,1,0);
     float sample_delta = 0.025f;
 
     int irradiance_map_w = IBL::IrradianceMapSize;
     int irradiance_map_h = IBL::IrradianceMapSize;
-    ibl.irradiance_map = Image2D<float3>(irradiance_map_w,irradiance_map_h);
-    parallel_forrange(0,irradiance_map_h,[&](int,int h){
+    ibl.irradiance_map = PackedTexture<RGB9E5>(irradiance_map_w,irradiance_map_h);
+    parallel_for(0,irradiance_map_h,[&](int h){
         for(int w = 0; w < irradiance_map_w; ++w){
-            float u = (w + 0.5f) / irradiance_map_w;
-            float v = (h + 0.5f) / irradiance_map_h;
-            auto N = sampleEquirectangularMap({u,v});
+            auto N = octahedralTexelDirection(w,h,irradiance_map_w);
 
             float3 s,t;
             coordinate(N,s,t);
@@ -376,108 +281,240 @@ void createIBLResource(IBL& ibl,const MipMap2D<float3>& env_mipmap)
                         std::cos(theta));
                     float3 world_dir = normalize(local_dir.x * s + local_dir.y * t + local_dir.z * N);
 
-                    auto uv = sampleSphericalMap(world_dir);
-                    irradiance += LinearSampler::sample2D(env_mipmap,uv.x,uv.y,0);
+                    irradiance += OctahedralSampler::sample(env_mipmap.get_level(0),world_dir);
                     ++sample_count;
                 }
             }
             irradiance /= static_cast<float>(sample_count);
-            ibl.irradiance_map.at(w,h) = irradiance;
+            ibl.irradiance_map.texel(w,h) = RGB9E5::encode(irradiance);
         }
     });
     LOG_INFO("finish generate irradiance map");
+}
+
+// one pass over environment texels, solid angle of an octahedral texel is proportional to cube of
+// L1 norm of its unit direction and border texels which are mirrored by the folding count half
+static void createIrradianceSH(IBL& ibl,const TextureRGB9E5& env_mipmap)
+{
+    const auto& env = env_mipmap.get_level(0);
+    const int size = env.width();
+    using Coefficients = std::array<float3,9>;
+    std::vector<Coefficients> row_sums(size);
+    std::vector<float> row_weights(size);
+    parallel_for(0,size,[&](int y){
+        Coefficients sum{};
+        float weight_sum = 0.f;
+        const float row_weight = (y == 0 || y == size - 1) ? 0.5f : 1.f;
+        for(int x = 0; x < size; ++x){
+            auto dir = octahedralTexelDirection(x,y,size);
+            float l1 = std::abs(dir.x) + std::abs(dir.y) + std::abs(dir.z);
+            float weight = l1 * l1 * l1 * row_weight * ((x == 0 || x == size - 1) ? 0.5f : 1.f);
+            float sh[9];
+            SHBasis9(dir.x,dir.y,dir.z,sh);
+            const float3 radiance = env(x,y) * weight;
+            for(int i = 0; i < 9; ++i){
+                sum[i] += radiance * sh[i];
+            }
+            weight_sum += weight;
+        }
+        row_sums[y] = sum;
+        row_weights[y] = weight_sum;
+    });
+
+    Coefficients radiance_sh{};
+    float total_weight = 0.f;
+    for(int y = 0; y < size; ++y){
+        for(int i = 0; i < 9; ++i){
+            radiance_sh[i] += row_sums[y][i];
+        }
+        total_weight += row_weights[y];
+    }
+    // weights are normalized to cover the whole sphere, then cosine lobe convolution scales band l
+    // by A_l / PI which is 1, 2 / 3 and 1 / 4
+    const float to_solid_angle = 4.f * PI / total_weight;
+    constexpr float band_scale[9] = {1.f, 2.f / 3.f, 2.f / 3.f, 2.f / 3.f, 0.25f, 0.25f, 0.25f, 0.25f, 0.25f};
+    for(int i = 0; i < 9; ++i){
+        ibl.irradiance_sh[i] = radiance_sh[i] * (to_solid_angle * band_scale[i]);
+    }
+    LOG_INFO("finish project irradiance into spherical harmonics");
+}
+
+namespace {
+    // one direction of a prefilter level in tangent space of N, with the env mip its pdf asks for
+    struct PrefilterSample
+    {
+        float3 L;
+        float mip_level;
+    };
+
+    // with V = R = N every texel of a level integrates the same GGX lobe around its own N,
+    // so importance samples are generated once per level instead of once per texel
+    struct PrefilterTable
+    {
+        std::vector<PrefilterSample> samples;
+        float total_weight = 0.f;
+    };
+
+    PrefilterTable CreatePrefilterTable(float roughness, int level_size, int sample_count)
+    {
+        PrefilterTable table;
+        // lobe of zero roughness is a delta so all samples are N itself
+        if(roughness == 0.f){
+            table.samples.push_back({float3(0.f,0.f,1.f),0.f});
+            table.total_weight = 1.f;
+            return table;
+        }
+        const float sa_texel = 4.f * PI / (6.f * level_size * level_size);
+        for(int i = 0; i < sample_count; ++i){
+            float2 xi = Hammersley(i,sample_count);
+            float3 H  = ImportanceSampleGGXLocal(xi,roughness);
+            float3 L  = normalize(2.f * H.z * H - float3(0.f,0.f,1.f));
+
+            float NdotL = std::max(L.z,0.f);
+            if(NdotL > 0.f){
+                float D     = DistributionGGX(float3(0.f,0.f,1.f),H,roughness);
+                float NdotH = std::max(H.z,0.f);
+                float HdotV = std::max(H.z,0.f);
+                float pdf   = D * NdotH / (4.f * HdotV) + 0.0001f;
+
+                float sa_sample = 1.f / (sample_count * pdf + 0.0001f);
+
+                float mip_level = 0.5f * std::log2(sa_sample / sa_texel);
+
+                table.samples.push_back({L,mip_level});
+                table.total_weight += NdotL;
+            }
+        }
+        return table;
+    }
+
+    // texels [begin,end) of prefilter level
+    struct PrefilterJob
+    {
+        int level;
+        int begin, end;
+    };
+}
+
+static void createPrefilterMap(IBL& ibl,const TextureRGB9E5& env_mipmap)
+{
+    // texels of every job cost about the same
+    constexpr int JobTexelCount = 256;
 
-    int prefilter_map_w = IBL::PrefilterMapSize;
-    int prefilter_map_h = IBL::PrefilterMapSize;
     int prefilter_sample_count = IBL::PrefilterSampleCount;
-    ibl.prefilter_map.generate(prefilter_map_w,prefilter_map_h);
+    ibl.prefilter_map.generate(IBL::PrefilterMapSize,IBL::PrefilterMapSize);
     LOG_INFO("prefilter map levels: {}",ibl.prefilter_map.levels());
     int mip_levels = ibl.prefilter_map.levels();
+
+    std::vector<PrefilterTable> tables(mip_levels);
+    std::vector<PrefilterJob> jobs;
     for(int i = 0; i < mip_levels; ++i){
         float roughness = i * 1.f / (mip_levels - 1);
-        int cur_prefilter_map_h = prefilter_map_h >> i;
-        int cur_prefilter_map_w = prefilter_map_w >> i;
-        parallel_forrange(0,cur_prefilter_map_h,[&](int,int h){
-            for(int w = 0; w < cur_prefilter_map_w; ++w){
-                float u = (w + 0.5f) / cur_prefilter_map_w;
-                float v = (h + 0.5f) / cur_prefilter_map_h;
-
-                auto N = sampleEquirectangularMap({u,v});
-                float3 R = N;
-                float3 V = R;
-
-                float3 prefilter_color = float3(0);
-                float total_weight = 0.f;
-                for(int i = 0; i < prefilter_sample_count; ++i){
-                    float2 xi = Hammersley(i,prefilter_sample_count);
-                    float3 H  = ImportanceSampleGGX(xi,N,roughness);
-                    float3 L  = normalize(2.f * dot(V,H) * H - V);
-
-                    float NdotL = std::max(dot(N,L),0.f);
-
-                    if(NdotL > 0.f){
-                        auto uv = sampleSphericalMap(L);
-                        //prefilter_color += LinearSampler::sample2D(*env_mipmap, uv.x,uv.y,0) * NdotL;
-                        //total_weight += NdotL;
-
-                        float D     = DistributionGGX(N,H,roughness);
-                        float NdotH = std::max(dot(N,H),0.f);
-                        float HdotV = std::max(dot(H,V),0.f);
-                        float pdf   = D * NdotH / (4.f * HdotV) + 0.0001f;
-
-                        float sa_texel  = 4.f * PI / (6.f * cur_prefilter_map_w * cur_prefilter_map_h);
-                        float sa_sample = 1.f / (prefilter_sample_count * pdf + 0.0001f);
-
-                        float mip_level = roughness == 0.f ? 0.f : 0.5f * std::log2(sa_sample / sa_texel);
-
-                        prefilter_color += LinearSampler::sample2D(env_mipmap,uv.x,uv.y,mip_level);
-                        total_weight    += NdotL;
-                    }
-                }
-                prefilter_color /= total_weight;
-                ibl.prefilter_map.get_level(i).at(w,h) = prefilter_color;
-            }
-        });
+        const auto& level = ibl.prefilter_map.get_level(i);
+        tables[i] = CreatePrefilterTable(roughness,level.width(),prefilter_sample_count);
+        const int texel_count = level.width() * level.height();
+        for(int begin = 0; begin < texel_count; begin += JobTexelCount){
+            jobs.push_back({i,begin,std::min(begin + JobTexelCount,texel_count)});
+        }
     }
+
+    // jobs of all levels run at once, so small levels do not leave workers idle behind a barrier
+    parallel_for(0,static_cast<int>(jobs.size()),[&](int j){
+        const auto& job = jobs[j];
+        const auto& table = tables[job.level];
+        auto& level = ibl.prefilter_map.get_level(job.level);
+        const int size = level.width();
+        for(int texel = job.begin; texel < job.end; ++texel){
+            const int w = texel % size;
+            const int h = texel / size;
+            auto N = octahedralTexelDirection(w,h,size);
+            float3 s,t;
+            coordinate(N,s,t);
+
+            float3 prefilter_color = float3(0);
+            for(const auto& sample : table.samples){
+                float3 L = sample.L.x * s + sample.L.y * t + sample.L.z * N;
+                //prefilter_color += OctahedralSampler::sample(env_mipmap,L,0) * NdotL;
+                prefilter_color += OctahedralSampler::sample(env_mipmap,L,sample.mip_level);
+            }
+            level.texel(w,h) = RGB9E5::encode(prefilter_color / table.total_weight);
+        }
+    },1);
     LOG_INFO("finish generate prefilter map");
+}
+
+float2 integrateBRDF(float NdotV,float roughness)
+{
+    // grazing view has no reflection left to integrate
+    NdotV = std::max(NdotV,1e-4f);
 
-    int brdf_lut_w = IBL::BRDFLUTSize;
-    int brdf_lut_h = IBL::BRDFLUTSize;
-    ibl.brdf_lut = Image<float2>(brdf_lut_w,brdf_lut_h);
+    float A = 0.f;
+    float B = 0.f;
+
+    float3 V = float3(sqrt(1.f - NdotV * NdotV),0.f,NdotV);
+    float3 N = float3(0.f,0.f,1.f);
     int brdf_sample_count = IBL::BRDFSampleCount;
-    parallel_forrange(0,brdf_lut_h,[&](int,int h){
-        for(int w = 0; w < brdf_lut_w; ++w){
-            float NdotV     = (w + 0.5f) / brdf_lut_w;
-            float roughness = (h + 0.5f) / brdf_lut_h;
-
-            float A = 0.f;
-            float B = 0.f;
-
-            float3 V = float3(sqrt(1.f - NdotV * NdotV),0.f,NdotV);
-            float3 N = float3(0.f,0.f,1.f);
-            for(int i = 0; i < brdf_sample_count; ++i){
-                float2 Xi = Hammersley(i,brdf_sample_count);
-                float3 H  = ImportanceSampleGGX(Xi,N,roughness);
-                float3 L  = normalize(2.f * dot(V,H) * H - V);
-
-                float NdotL = std::max(L.z,0.f);
-                float NdotH = std::max(H.z,0.f);
-                float VdotH = std::max(dot(V,H),0.f);
-                if(NdotL > 0.f){
-                    float G     = GeometrySmith(N,V,L,roughness);
-                    float G_Vis = (G*VdotH) / (NdotH * NdotV);
-                    float Fc    = std::pow(1.f - VdotH, 5.f);
-
-                    A += (1.f - Fc) * G_Vis;
-                    B += Fc * G_Vis;
-                }
+    for(int i = 0; i < brdf_sample_count; ++i){
+        float2 Xi = Hammersley(i,brdf_sample_count);
+        float3 H  = ImportanceSampleGGXLocal(Xi,roughness);
+        float3 L  = normalize(2.f * dot(V,H) * H - V);
+
+        float NdotL = std::max(L.z,0.f);
+        float NdotH = std::max(H.z,0.f);
+        float VdotH = std::max(dot(V,H),0.f);
+        if(NdotL > 0.f){
+            float G     = GeometrySmith(N,V,L,roughness);
+            float G_Vis = (G*VdotH) / (NdotH * NdotV);
+            float Fc    = std::pow(1.f - VdotH, 5.f);
+
+            A += (1.f - Fc) * G_Vis;
+            B += Fc * G_Vis;
+        }
+    }
+    return float2(A,B) / float(brdf_sample_count);
+}
+
+// generated by BRDFLUTGenerator, rows of roughness with (scale, bias) pairs
+extern const uint16_t BRDFLUTData[IBL::BRDFLUTSize * IBL::BRDFLUTSize * 2];
+
+const TextureRG16& getBRDFLUT()
+{
+    static const TextureRG16 lut = []{
+        TextureRG16 t(IBL::BRDFLUTSize,IBL::BRDFLUTSize);
+        for(int h = 0; h < IBL::BRDFLUTSize; ++h){
+            for(int w = 0; w < IBL::BRDFLUTSize; ++w){
+                const uint16_t* texel = BRDFLUTData + (h * IBL::BRDFLUTSize + w) * 2;
+                t.texel(w,h) = {texel[0],texel[1]};
             }
-            A /= brdf_sample_count;
-            B /= brdf_sample_count;
-            ibl.brdf_lut.at(w,h) = {A,B};
         }
-    });
-    LOG_INFO("finish generate brdf lut");
+        return t;
+    }();
+    return lut;
+}
+
+bool use_analytic_brdf = false;
+
+bool use_sh_irradiance = true;
+
+void createIBLResource(IBL& ibl,const TextureRGB9E5& env_mipmap)
+{
+    const bool use_cache = !ibl_cache_dir.empty();
+
+    // spherical harmonics cost less than reading a cache so they are never cached
+    if(use_sh_irradiance)
+        createIrradianceSH(ibl,env_mipmap);
+
+    const uint64_t env_key = use_cache ? IBLEnvironmentKey(env_mipmap) : 0;
+    if(use_cache && LoadIBLEnvironmentCache(ibl,env_key)){
+        LOG_INFO("load irradiance and prefilter map from cache");
+    }
+    else{
+        if(!use_sh_irradiance)
+            createIrradianceMap(ibl,env_mipmap);
+        createPrefilterMap(ibl,env_mipmap);
+        if(use_cache)
+            SaveIBLEnvironmentCache(ibl,env_key);
+    }
 }
 
 const IBL &Model::getIBL() const
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+
 #include "geometry.hpp"
 #include "mesh.hpp"
 #include "texture.hpp"
@@ -8,14 +10,31 @@ struct IBL{
     static constexpr int IrradianceMapSize    = 32;
     static constexpr int PrefilterMapSize     = 128;
     static constexpr int PrefilterSampleCount = 1024;
-    static constexpr int BRDFLUTSize          = 512;
+    // brdf lut is generated ahead of time, changing them needs BRDFLUTGenerator to run again
+    static constexpr int BRDFLUTSize          = 64;
     static constexpr int BRDFSampleCount      = 1024;
-    Texture<float3> irradiance_map;
-    MipMap2D<float3> prefilter_map;
-    Texture<float2> brdf_lut;
+    // irradiance and prefilter map are in octahedral layout
+    PackedTexture<RGB9E5> irradiance_map;
+    TextureRGB9E5 prefilter_map;
+    // L2 spherical harmonics coefficients of irradiance / PI, irradiance_map is left empty if they are used
+    std::array<float3, 9> irradiance_sh{};
 };
 
-void createIBLResource(IBL& ibl,const MipMap2D<float3>& env_mipmap);
+// irradiance is projected to spherical harmonics instead of being integrated into a map
+extern bool use_sh_irradiance;
+
+// results are read from or written into ibl_cache_dir if it is not empty
+void createIBLResource(IBL& ibl,const TextureRGB9E5& env_mipmap);
+
+// split sum scale and bias of F0 at one NdotV and roughness
+float2 integrateBRDF(float NdotV,float roughness);
+
+// brdf lut embedded in binary, texel (x, y) is at NdotV = x / (BRDFLUTSize - 1) and roughness = y / (BRDFLUTSize - 1),
+// it depends on no environment so all of them share it
+const TextureRG16& getBRDFLUT();
+
+// ibl shader uses an analytic fit of brdf lut instead of sampling it
+extern bool use_analytic_brdf;
 
 class Model
 {
@@ -54,17 +73,20 @@ class Model
 
     mat4 getModelMatrix() const;
 
-    const Texture<float3> *getAlbedoMap() const;
+    const TextureRGBA8 *getAlbedoMap() const;
+
+    const TextureRG8 *getNormalMap() const;
 
-    const Texture<float3> *getNormalMap() const;
+    const TextureR8 *getAOMap() const;
 
-    const Texture<float> *getAOMap() const;
+    const TextureR8 *getRoughnessMap() const;
 
-    const Texture<float> *getRoughnessMap() const;
+    const TextureR8 *getMetallicMap() const;
 
-    const Texture<float> *getMetallicMap() const;
+    const std::shared_ptr<TextureRGB9E5>& getEnvironmentMap() const;
 
-    const std::shared_ptr<MipMap2D<float3>>& getEnvironmentMap() const;
+    // level 0 of environment map
+    const PackedTexture<RGB9E5>& getSkyMap() const;
 
     const BoundBox3D &getBoundBox() const;
 
@@ -72,16 +94,19 @@ class Model
 
     friend class Scene;
   private:
-    Texture<float3> albedo;
-    Texture<float3> normal;
-    Texture<float> ambientO;
-    Texture<float> roughness;
-    Texture<float> metallic;
-
-    RC<MipMap2D<float3>> env_mipmap;
+    // material maps keep 8 bit texels and are decoded in sampler,
+    // they and mesh are shared with other models loaded from the same files
+    RC<const TextureRGBA8> albedo;
+    RC<const TextureRG8> normal;
+    RC<const TextureR8> ambientO;
+    RC<const TextureR8> roughness;
+    RC<const TextureR8> metallic;
+
+    // environment in octahedral layout which is looked up without trigonometric functions
+    RC<TextureRGB9E5> env_mipmap;
     IBL ibl;
 
-    Box<Mesh> mesh;
+    RC<const Mesh> mesh;
     BoundBox3D box;
     mat4 model_matrix{1.f};
 };
\ No newline at end of file
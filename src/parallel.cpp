@@ -1,67 +1,215 @@
 //
 // Created by wyz on 2022/5/31.
 //
+#include <iterator>
+
 #include "parallel.hpp"
 #include "logger.hpp"
 
-ThreadPool thread_pool(actual_worker_count(0));
+TaskScheduler task_scheduler(actual_worker_count(-1));
 
-// the constructor just launches some amount of workers
-ThreadPool::ThreadPool(size_t threads) : idle(threads), nthreads(threads), stop(false)
+namespace
 {
-    for (size_t i = 0; i < threads; ++i)
-        workers.emplace_back([this] {
-            while (true)
-            {
-                std::function<void()> task;
-                {
-                    std::unique_lock<std::mutex> lock(this->mut);
-                    this->cond.wait(lock, [this] { return this->stop || !this->tasks.empty(); });
-                    if (this->stop && this->tasks.empty())
-                    {
-                        return;
-                    }
-                    idle--;
-                    task = std::move(this->tasks.front());
-                    this->tasks.pop();
-                }
-
-                task();
-
-                idle++;
-                {
-                    std::lock_guard<std::mutex> lk(this->mut);
-                    if (idle.load() == this->nthreads && this->tasks.empty())
-                    {
-                        waitCond.notify_all();
-                    }
-                }
-            }
-        });
+thread_local TaskScheduler *current_scheduler = nullptr;
+thread_local int current_worker_index = -1;
+// group of the task running on this thread, parent of groups created by it
+thread_local const TaskGroup *current_group = nullptr;
+} // namespace
+
+TaskScheduler::TaskScheduler(int worker_count) : queued(0), stop(false), push_count(0), waiter_count(0)
+{
+    for (int i = 0; i <= worker_count; ++i)
+        queues.emplace_back(std::make_unique<TaskQueue>());
+    for (int i = 0; i < worker_count; ++i)
+        workers.emplace_back([this, i] { workerLoop(i); });
 }
 
+TaskScheduler::~TaskScheduler()
+{
+    {
+        std::lock_guard<std::mutex> lk(sleep_mut);
+        stop = true;
+    }
+    sleep_cond.notify_all();
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+}
 
+int TaskScheduler::currentWorkerIndex()
+{
+    return current_worker_index;
+}
 
-void ThreadPool::Wait()
+void TaskScheduler::push(Task task)
 {
-    std::unique_lock<std::mutex> l(mut);
-    waitCond.wait(l,[this]() {
-        LOG_DEBUG("wait print: {} {}",this->idle.load(),tasks.size());
-        return this->idle.load() == nthreads && tasks.empty();
-    });
-    LOG_DEBUG("print: {} {}",this->idle.load(),tasks.size());
+    // workers push to their own deque, other threads to the injection queue
+    int index = current_scheduler == this ? current_worker_index : workerCount();
+    {
+        auto &queue = *queues[index];
+        std::lock_guard<std::mutex> lk(queue.mut);
+        queue.tasks.emplace_back(std::move(task));
+    }
+    queued.fetch_add(1, std::memory_order_release);
+    // take the sleep lock so a worker checking queued can't miss the notification
+    {
+        std::lock_guard<std::mutex> lk(sleep_mut);
+    }
+    sleep_cond.notify_one();
+    push_count.fetch_add(1);
+    if (waiter_count.load() > 0)
+        notifyWaiters();
 }
 
-// the destructor joins all threads
-ThreadPool::~ThreadPool()
+void TaskScheduler::notifyWaiters()
 {
+    // same as above, a waiter checks its condition under wait_mut
     {
-        std::unique_lock<std::mutex> lock(mut);
-        stop = true;
+        std::lock_guard<std::mutex> lk(wait_mut);
     }
-    cond.notify_all();
-    for (std::thread &worker : workers)
+    wait_cond.notify_all();
+}
+
+std::optional<TaskScheduler::Task> TaskScheduler::take(const TaskGroup *group)
+{
+    if (queued.load(std::memory_order_acquire) == 0)
+        return std::nullopt;
+
+    const int queue_count = static_cast<int>(queues.size());
+    const int self = current_scheduler == this ? current_worker_index : workerCount();
+    auto eligible = [group](const Task &task) { return !group || task.group->nestedIn(group); };
+
+    // newest own task first because its data is most likely still in cache
     {
-        worker.join();
+        auto &queue = *queues[self];
+        std::lock_guard<std::mutex> lk(queue.mut);
+        auto it = std::find_if(queue.tasks.rbegin(), queue.tasks.rend(), eligible);
+        if (it != queue.tasks.rend())
+        {
+            Task task = std::move(*it);
+            queue.tasks.erase(std::next(it).base());
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            return task;
+        }
+    }
+    // then steal the oldest task of others which is usually the largest piece of work
+    for (int k = 1; k < queue_count; ++k)
+    {
+        auto &queue = *queues[(self + k) % queue_count];
+        std::lock_guard<std::mutex> lk(queue.mut);
+        auto it = std::find_if(queue.tasks.begin(), queue.tasks.end(), eligible);
+        if (it != queue.tasks.end())
+        {
+            Task task = std::move(*it);
+            queue.tasks.erase(it);
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            return task;
+        }
+    }
+    return std::nullopt;
+}
+
+bool TaskScheduler::runOne(const TaskGroup *group)
+{
+    auto task = take(group);
+    if (!task)
+        return false;
+    const TaskGroup *outer_group = current_group;
+    current_group = task->group;
+    std::exception_ptr except = nullptr;
+    try
+    {
+        task->func();
+    }
+    catch (...)
+    {
+        except = std::current_exception();
+    }
+    current_group = outer_group;
+    task->group->finish(except);
+    return true;
+}
+
+void TaskScheduler::workerLoop(int index)
+{
+    current_scheduler = this;
+    current_worker_index = index;
+    while (true)
+    {
+        if (runOne())
+            continue;
+        std::unique_lock<std::mutex> lk(sleep_mut);
+        sleep_cond.wait(lk, [this] { return stop || queued.load(std::memory_order_acquire) > 0; });
+        if (stop && queued.load(std::memory_order_acquire) == 0)
+            return;
+    }
+}
+
+TaskGroup::TaskGroup(TaskScheduler &scheduler) : scheduler(scheduler), parent(current_group), pending(0)
+{
+}
+
+TaskGroup::~TaskGroup()
+{
+    try
+    {
+        wait();
+    }
+    catch (const std::exception &err)
+    {
+        LOG_ERROR("task group exception dropped: {}", err.what());
     }
-}
\ No newline at end of file
+    catch (...)
+    {
+        LOG_ERROR("task group exception dropped");
+    }
+}
+
+void TaskGroup::finish(std::exception_ptr except)
+{
+    if (except)
+    {
+        std::lock_guard<std::mutex> lk(except_mutex);
+        if (!except_ptr)
+            except_ptr = except;
+    }
+    // this may be destroyed by its waiter as soon as pending drops to 0
+    TaskScheduler &owner = scheduler;
+    if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        owner.notifyWaiters();
+}
+
+bool TaskGroup::nestedIn(const TaskGroup *group) const
+{
+    for (const TaskGroup *g = this; g; g = g->parent)
+    {
+        if (g == group)
+            return true;
+    }
+    return false;
+}
+
+void TaskGroup::wait()
+{
+    while (pending.load(std::memory_order_acquire) > 0)
+    {
+        // read before looking for a task so a push after the failed look wakes us up
+        const uint64_t seen_push_count = scheduler.push_count.load();
+        if (scheduler.runOne(this))
+            continue;
+        std::unique_lock<std::mutex> lk(scheduler.wait_mut);
+        scheduler.waiter_count.fetch_add(1);
+        scheduler.wait_cond.wait(lk, [&] {
+            return pending.load(std::memory_order_acquire) == 0 || scheduler.push_count.load() != seen_push_count;
+        });
+        scheduler.waiter_count.fetch_sub(1);
+    }
+    std::exception_ptr except = nullptr;
+    {
+        std::lock_guard<std::mutex> lk(except_mutex);
+        std::swap(except, except_ptr);
+    }
+    if (except)
+        std::rethrow_exception(except);
+}
@@ -1,13 +1,18 @@
 #ifndef SOFTPBRRENDERER_PARALLEL_HPP
 #define SOFTPBRRENDERER_PARALLEL_HPP
 
-#include <thread>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
 #include <mutex>
-#include <vector>
 #include <optional>
-#include <functional>
-#include <queue>
-#include <future>
+#include <thread>
+#include <vector>
 
 inline int actual_worker_count(int worker_count) noexcept
 {
@@ -16,101 +21,149 @@ inline int actual_worker_count(int worker_count) noexcept
     return (std::max)(1, worker_count);
 }
 
-struct ThreadPool
+class TaskGroup;
+
+/**
+ * @brief work-stealing scheduler: every worker owns a deque, pops its own tasks from the back
+ * and steals from the front of others' when it runs out. Tasks submitted by threads outside
+ * the scheduler go to a shared injection queue which is stolen from in the same way.
+ * Threads waiting on a task group only run tasks of that group or of groups nested in it,
+ * so e.g. the render thread never picks up a long scene loading job while waiting for its own.
+ */
+class TaskScheduler
 {
-    ThreadPool(size_t);
+  public:
+    explicit TaskScheduler(int worker_count);
+
+    ~TaskScheduler();
+
+    TaskScheduler(const TaskScheduler &) = delete;
+
+    TaskScheduler &operator=(const TaskScheduler &) = delete;
+
+    int workerCount() const
+    {
+        return static_cast<int>(workers.size());
+    }
+
+    // index of calling thread in [0, workerCount()), or -1 if it is not a worker of any scheduler
+    static int currentWorkerIndex();
+
+  private:
+    friend class TaskGroup;
+
+    struct Task
+    {
+        std::function<void()> func;
+        TaskGroup *group;
+    };
+
+    struct TaskQueue
+    {
+        std::mutex mut;
+        std::deque<Task> tasks;
+    };
 
-    ~ThreadPool();
+    void push(Task task);
 
-    template <typename F, typename... Args>
-    auto AppendTask(F &&f, Args &&... args);
+    // take any task if group is null, otherwise only tasks of group or groups nested in it
+    std::optional<Task> take(const TaskGroup *group);
 
-    void Wait();
+    // run one queued task if any, used by workers and by threads waiting on a task group
+    bool runOne(const TaskGroup *group = nullptr);
+
+    // wake threads blocked in TaskGroup::wait to check their group again
+    void notifyWaiters();
+
+    void workerLoop(int index);
 
   private:
     std::vector<std::thread> workers;
-    std::queue<std::function<void()>> tasks;
-    std::mutex mut;
-    std::atomic<size_t> idle;
-    std::condition_variable cond;
-    std::condition_variable waitCond;
-    size_t nthreads;
+    // one queue per worker and the injection queue at last
+    std::vector<std::unique_ptr<TaskQueue>> queues;
+    std::atomic<int> queued;
+    std::mutex sleep_mut;
+    std::condition_variable sleep_cond;
     bool stop;
+    // TaskGroup::wait blocks here until a task is pushed or its group finishes
+    std::atomic<uint64_t> push_count;
+    std::atomic<int> waiter_count;
+    std::mutex wait_mut;
+    std::condition_variable wait_cond;
 };
 
-// add new work item to the pool
-template <class F, class... Args> auto ThreadPool::AppendTask(F &&f, Args &&... args)
+// shared by renderer, zbuffer and IBL precompute, caller thread also works while waiting so it has one
+// less worker than hardware threads
+extern TaskScheduler task_scheduler;
+
+/**
+ * @brief tasks spawned by run() are waited by wait() of the same group only, so nested or concurrent
+ * parallel regions never wait for each other. The waiting thread executes queued tasks of this group
+ * and of groups created inside its tasks meanwhile, and sleeps when there is none of them.
+ */
+class TaskGroup
 {
-    using return_type = typename std::invoke_result<F,Args...>::type;
-    auto task = std::make_shared<std::packaged_task<return_type()>>(std::bind(std::forward<F>(f), std::forward<Args>(args)...));
-    std::future<return_type> res = task->get_future();
+  public:
+    explicit TaskGroup(TaskScheduler &scheduler = task_scheduler);
+
+    // wait for remaining tasks but drop their exception
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup &) = delete;
+
+    TaskGroup &operator=(const TaskGroup &) = delete;
+
+    template <typename F> void run(F &&f)
     {
-        std::unique_lock<std::mutex> lock(mut);
-        // don't allow enqueueing after stopping the pool
-        if (stop)
-        {
-            throw std::runtime_error("enqueue on stopped ThreadPool");
-        }
-        tasks.emplace([task]() { (*task)(); });
+        pending.fetch_add(1, std::memory_order_relaxed);
+        scheduler.push({std::forward<F>(f), this});
     }
-    cond.notify_one();
-    return res;
-}
 
-//parallel_forrange will frequently call so using a thread pool is a good choice
-extern ThreadPool thread_pool;
+    // rethrow the first exception thrown by tasks of this group
+    void wait();
 
-template<typename T, typename Func>
-void parallel_forrange(T beg, T end, Func &&func, int worker_count = 0)
-{
-    std::mutex it_mutex;
-    T it = beg;
-    auto next_item = [&]() -> std::optional<T>
-    {
-        std::lock_guard lk(it_mutex);
-        if(it == end)
-            return std::nullopt;
-        return std::make_optional(it++);
-    };
+  private:
+    friend class TaskScheduler;
 
-    std::mutex except_mutex;
-    std::exception_ptr except_ptr = nullptr;
+    void finish(std::exception_ptr except);
 
-    worker_count = actual_worker_count(worker_count);
+    // whether this is group or nested in it
+    bool nestedIn(const TaskGroup *group) const;
 
-    auto worker_func = [&](int thread_index)
-    {
-        for(;;)
-        {
-            auto item = next_item();
-            if(!item)
-                break;
-
-            try
-            {
-                func(thread_index, *item);
-            }
-            catch(...)
-            {
-                std::lock_guard lk(except_mutex);
-                if(!except_ptr)
-                    except_ptr = std::current_exception();
-            }
-
-            std::lock_guard lk(except_mutex);
-            if(except_ptr)
-                break;
-        }
-    };
+    TaskScheduler &scheduler;
+    // group of the task which created this one, outlives this as the task waits for it
+    const TaskGroup *parent;
+    std::atomic<int> pending;
+    std::mutex except_mutex;
+    std::exception_ptr except_ptr = nullptr;
+};
 
-    for(int i = 0; i < worker_count; ++i){
-        thread_pool.AppendTask(worker_func,i);
+// call func(i) for i in [beg, end) in chunks of grain items,
+// non-positive grain splits the range into about 4 chunks per thread
+template <typename T, typename Func>
+void parallel_for(T beg, T end, Func &&func, T grain = 0)
+{
+    if(beg >= end)
+        return;
+    const T count = end - beg;
+    if(grain <= 0)
+        grain = (std::max)(static_cast<T>(1), static_cast<T>(count / ((task_scheduler.workerCount() + 1) * 4)));
+    if(count <= grain){
+        for(T i = beg; i < end; ++i)
+            func(i);
+        return;
     }
 
-    thread_pool.Wait();
-
-    if(except_ptr)
-        std::rethrow_exception(except_ptr);
+    TaskGroup group;
+    for(T chunk_beg = beg; chunk_beg < end;){
+        const T chunk_end = chunk_beg + (std::min)(grain, static_cast<T>(end - chunk_beg));
+        group.run([&func, chunk_beg, chunk_end] {
+            for(T i = chunk_beg; i < chunk_end; ++i)
+                func(i);
+        });
+        chunk_beg = chunk_end;
+    }
+    group.wait();
 }
 
 #endif // SOFTPBRRENDERER_PARALLEL_HPP
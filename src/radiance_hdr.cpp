@@ -0,0 +1,174 @@
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "parallel.hpp"
+#include "radiance_hdr.hpp"
+
+namespace
+{
+// 2^(e - 136) which turns a mantissa byte into its value, the same as stb_image does
+const std::array<float, 256> RGBEScaleTable = [] {
+    std::array<float, 256> t{};
+    for (int e = 1; e < 256; e++)
+        t[e] = std::ldexp(1.f, e - (128 + 8));
+    return t;
+}();
+
+void DecodeRGBE(const uint8_t *rgbe, int count, float3 *dst)
+{
+    for (int i = 0; i < count; i++, rgbe += 4)
+    {
+        const float scale = RGBEScaleTable[rgbe[3]];
+        dst[i] = {rgbe[0] * scale, rgbe[1] * scale, rgbe[2] * scale};
+    }
+}
+
+bool StartsWith(const uint8_t *data, size_t size, const char *prefix)
+{
+    const size_t n = strlen(prefix);
+    return size >= n && memcmp(data, prefix, n) == 0;
+}
+
+class Reader
+{
+  public:
+    Reader(const uint8_t *data, size_t size) : p(data), end(data + size)
+    {
+    }
+
+    // line without '\n', throw at the end of data
+    std::string line()
+    {
+        auto nl = static_cast<const uint8_t *>(memchr(p, '\n', end - p));
+        if (!nl)
+            throw std::runtime_error("radiance hdr header is truncated");
+        std::string s(reinterpret_cast<const char *>(p), nl - p);
+        p = nl + 1;
+        return s;
+    }
+
+    const uint8_t *pos() const
+    {
+        return p;
+    }
+
+  private:
+    const uint8_t *p;
+    const uint8_t *end;
+};
+
+// new style scanline: 2, 2, width >> 8, width & 0xff and then four run length encoded channel planes
+bool IsRLEScanline(const uint8_t *p, const uint8_t *end, int w)
+{
+    return end - p >= 4 && p[0] == 2 && p[1] == 2 && !(p[2] & 0x80) && ((p[2] << 8) | p[3]) == w;
+}
+
+// skip one run length encoded channel plane of w bytes, return nullptr if it is broken
+const uint8_t *SkipRLEChannel(const uint8_t *p, const uint8_t *end, int w)
+{
+    for (int x = 0; x < w;)
+    {
+        if (p >= end)
+            return nullptr;
+        int count = *p++;
+        const bool run = count > 128;
+        if (run)
+            count -= 128;
+        if (count == 0 || x + count > w)
+            return nullptr;
+        p += run ? 1 : count;
+        x += count;
+    }
+    return p <= end ? p : nullptr;
+}
+
+// channel c of rgbe row from the plane at p which is known to be valid
+const uint8_t *DecodeRLEChannel(const uint8_t *p, int w, int c, uint8_t *rgbe)
+{
+    for (int x = 0; x < w;)
+    {
+        int count = *p++;
+        if (count > 128)
+        {
+            count -= 128;
+            const uint8_t value = *p++;
+            for (int i = 0; i < count; i++)
+                rgbe[(x + i) * 4 + c] = value;
+        }
+        else
+        {
+            for (int i = 0; i < count; i++)
+                rgbe[(x + i) * 4 + c] = p[i];
+            p += count;
+        }
+        x += count;
+    }
+    return p;
+}
+} // namespace
+
+bool IsRadianceHDR(const uint8_t *data, size_t size)
+{
+    return StartsWith(data, size, "#?RADIANCE") || StartsWith(data, size, "#?RGBE");
+}
+
+Image2D<float3> DecodeRadianceHDR(const uint8_t *data, size_t size)
+{
+    if (!IsRadianceHDR(data, size))
+        throw std::runtime_error("not a radiance hdr file");
+
+    Reader reader(data, size);
+    reader.line();
+    for (std::string line = reader.line(); !line.empty(); line = reader.line())
+    {
+        if (line.rfind("FORMAT=", 0) == 0 && line != "FORMAT=32-bit_rle_rgbe")
+            throw std::runtime_error("unsupported radiance hdr format: " + line);
+    }
+    int w = 0, h = 0;
+    if (std::sscanf(reader.line().c_str(), "-Y %d +X %d", &h, &w) != 2 || w <= 0 || h <= 0)
+        throw std::runtime_error("unsupported radiance hdr orientation");
+
+    const uint8_t *pixels = reader.pos();
+    const uint8_t *end = data + size;
+    Image2D<float3> image(w, h);
+
+    // widths out of [8, 32767] can not be run length encoded, neither can a file whose first row is not
+    if (w < 8 || w > 32767 || !IsRLEScanline(pixels, end, w))
+    {
+        if (static_cast<size_t>(end - pixels) < static_cast<size_t>(w) * h * 4)
+            throw std::runtime_error("radiance hdr pixels are truncated");
+        parallel_for(0, h, [&](int y) {
+            DecodeRGBE(pixels + static_cast<size_t>(y) * w * 4, w, image.data() + static_cast<size_t>(y) * w);
+        });
+        return image;
+    }
+
+    // row lengths are only known by walking their runs, which is much cheaper than expanding them
+    std::vector<const uint8_t *> rows(h);
+    const uint8_t *p = pixels;
+    for (int y = 0; y < h; y++)
+    {
+        if (!IsRLEScanline(p, end, w))
+            throw std::runtime_error("radiance hdr scanline is broken");
+        rows[y] = p;
+        p += 4;
+        for (int c = 0; c < 4 && p; c++)
+            p = SkipRLEChannel(p, end, w);
+        if (!p)
+            throw std::runtime_error("radiance hdr scanline is broken");
+    }
+
+    parallel_for(0, h, [&](int y) {
+        std::vector<uint8_t> rgbe(static_cast<size_t>(w) * 4);
+        const uint8_t *q = rows[y] + 4;
+        for (int c = 0; c < 4; c++)
+            q = DecodeRLEChannel(q, w, c, rgbe.data());
+        DecodeRGBE(rgbe.data(), w, image.data() + static_cast<size_t>(y) * w);
+    });
+    return image;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "buffer.hpp"
+#include "common.hpp"
+
+// true if data starts with the magic line of a Radiance .hdr file
+bool IsRadianceHDR(const uint8_t *data, size_t size);
+
+// decode a Radiance .hdr in memory (usually a MappedFile) into linear rgb, rows are top to bottom.
+// rgbe scanlines, flat or run length encoded, are located in one pass and then decoded in parallel
+// straight into the image, throw if the file is broken or not in the -Y h +X w orientation
+Image2D<float3> DecodeRadianceHDR(const uint8_t *data, size_t size);
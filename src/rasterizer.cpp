@@ -1,6 +1,12 @@
 #include "rasterizer.hpp"
 #include <algorithm>
 #include <iostream>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#define RASTER_USE_SSE
+#include <emmintrin.h>
+#endif
+
 const uint8_t Rasterizer::gammaTable[256] = {
     0,   21,  28,  34,  39,  43,  46,  50,  53,  56,  59,  61,  64,  66,  68,  70,  72,  74,  76,  78,  80,  82,
     84,  85,  87,  89,  90,  92,  93,  95,  96,  98,  99,  101, 102, 103, 105, 106, 107, 109, 110, 111, 112, 114,
@@ -27,62 +33,302 @@ inline auto interpolate(float alpha, float beta, float gamma, const T &v1, const
     return (alpha * v1 + beta * v2 + gamma * v3) * inv_weight;
 }
 
-bool Rasterizer::rasterTriangle(Triangle &triangle,const IShader &shader, Image<color4b> &pixels, ZBuffer &zBuffer)
+namespace
+{
+// perspective corrected barycentric weight of one vertex which is linear in screen space
+// f(x,y) = a * (x - ox) + b * (y - oy) where (ox,oy) is a vertex on the opposite edge
+struct EdgeFunction
+{
+    float a, b;
+    float ox, oy;
+
+    float eval(float x, float y) const
+    {
+        return a * (x - ox) + b * (y - oy);
+    }
+};
+
+// walk all pixels of a screen space triangle inside [xMin,xMax]x[yMin,yMax] and call
+// func(x, y, alpha, beta, gamma) for covered ones with perspective corrected but not normalized weights
+template <typename Func>
+bool traverseTriangle(const Triangle &triangle, int w, int h, ZBuffer &zBuffer, int xMin, int yMin, int xMax, int yMax,
+                      Func &&func)
 {
     const auto &v = triangle.vertices;
-    float cc1 = v[0].gl_Position.x * (v[1].gl_Position.y - v[2].gl_Position.y) +
-                v[0].gl_Position.y * (v[2].gl_Position.x - v[1].gl_Position.x) +
-                v[1].gl_Position.x * v[2].gl_Position.y - v[2].gl_Position.x * v[1].gl_Position.y;
-    float cc2 = v[1].gl_Position.x * (v[2].gl_Position.y - v[0].gl_Position.y) +
-                v[1].gl_Position.y * (v[0].gl_Position.x - v[2].gl_Position.x) +
-                v[2].gl_Position.x * v[0].gl_Position.y - v[0].gl_Position.x * v[2].gl_Position.y;
-    float cc3 = v[2].gl_Position.x * (v[0].gl_Position.y - v[1].gl_Position.y) +
-                v[2].gl_Position.y * (v[1].gl_Position.x - v[0].gl_Position.x) +
-                v[0].gl_Position.x * v[1].gl_Position.y - v[1].gl_Position.x * v[0].gl_Position.y;
 
-    //[-1,1] -> [0.5,w-0.5]
-    viewportTransform(triangle, pixels.width(), pixels.height());
+    // setup edge functions once, each one is scaled by 1 / (cc * w) so it directly gives
+    // the perspective corrected weight and is non-negative inside the triangle whatever the winding
+    EdgeFunction edges[3];
+    for (int i = 0; i < 3; i++)
+    {
+        const auto &pa = v[(i + 1) % 3].gl_Position;
+        const auto &pb = v[(i + 2) % 3].gl_Position;
+        const auto &pc = v[i].gl_Position;
+        float a = pa.y - pb.y;
+        float b = pb.x - pa.x;
+        float cc = a * (pc.x - pa.x) + b * (pc.y - pa.y);
+        if (cc == 0.f)
+            return false;
+        float k = 1.f / (cc * pc.w);
+        edges[i] = {a * k, b * k, pa.x, pa.y};
+    }
 
     int min_x, min_y, max_x, max_y;
-    triangleBoundBox(triangle, min_x, min_y, max_x, max_y, pixels.width(), pixels.height());
+    Rasterizer::triangleBoundBox(triangle, min_x, min_y, max_x, max_y, w, h);
+    min_x = std::max(min_x, xMin);
+    min_y = std::max(min_y, yMin);
+    max_x = std::min(max_x, xMax);
+    max_y = std::min(max_y, yMax);
+    if (min_x > max_x || min_y > max_y)
+        return false;
 
     if (!zBuffer.zTest({{(float)min_x, (float)min_y}, {(float)max_x, (float)max_y}},
-                       std::min({triangle.vertices[0].gl_Position.z, triangle.vertices[1].gl_Position.z,
-                                 triangle.vertices[2].gl_Position.z})))
+                       std::min({v[0].gl_Position.z, v[1].gl_Position.z, v[2].gl_Position.z})))
     {
         return false;
     }
 
-    for (int r = min_y; r <= max_y; r++)
+    for (int by0 = min_y; by0 <= max_y; by0 += Rasterizer::BlockSize)
     {
-        for (int c = min_x; c <= max_x; c++)
+        const int by1 = std::min(by0 + Rasterizer::BlockSize - 1, max_y);
+        for (int bx0 = min_x; bx0 <= max_x; bx0 += Rasterizer::BlockSize)
         {
-            auto [alpha, beta, gamma] = computeBarycentric2D(c + 0.5f, r + 0.5f, triangle);
-            if (!insideTriangle(alpha, beta, gamma))
+            const int bx1 = std::min(bx0 + Rasterizer::BlockSize - 1, max_x);
+
+            // edge functions are linear so testing the two extreme pixel centers of the block
+            // against each edge tells if the block is entirely outside or entirely covered
+            bool outside = false;
+            bool covered = true;
+            for (const auto &e : edges)
+            {
+                float far_x  = (e.a > 0.f ? bx1 : bx0) + 0.5f;
+                float far_y  = (e.b > 0.f ? by1 : by0) + 0.5f;
+                float near_x = (e.a > 0.f ? bx0 : bx1) + 0.5f;
+                float near_y = (e.b > 0.f ? by0 : by1) + 0.5f;
+                if (e.eval(far_x, far_y) < 0.f)
+                {
+                    outside = true;
+                    break;
+                }
+                if (e.eval(near_x, near_y) < 0.f)
+                    covered = false;
+            }
+            if (outside)
                 continue;
-            alpha /= cc1;
-            beta /= cc2;
-            gamma /= cc3;
-            auto inv_weight = 1.f / (alpha + beta + gamma);
-            float frag_z = interpolate(alpha, beta, gamma,
-                                       v[0].gl_Position.z, v[1].gl_Position.z, v[2].gl_Position.z, inv_weight);
-            if (zBuffer.zTest(c, r, frag_z))
+
+            if (covered)
             {
-                auto frag_pos      = interpolate(alpha, beta, gamma, v[0].pos, v[1].pos, v[2].pos, inv_weight);
-                auto frag_normal   = interpolate(alpha, beta, gamma, v[0].normal, v[1].normal, v[2].normal, inv_weight);
-                auto frag_texcoord = interpolate(alpha, beta, gamma, v[0].tex_coord, v[1].tex_coord, v[2].tex_coord, inv_weight);
+                for (int r = by0; r <= by1; r++)
+                {
+                    float f0 = edges[0].eval(bx0 + 0.5f, r + 0.5f);
+                    float f1 = edges[1].eval(bx0 + 0.5f, r + 0.5f);
+                    float f2 = edges[2].eval(bx0 + 0.5f, r + 0.5f);
+                    for (int c = bx0; c <= bx1; c++)
+                    {
+                        func(c, r, f0, f1, f2);
+                        f0 += edges[0].a;
+                        f1 += edges[1].a;
+                        f2 += edges[2].a;
+                    }
+                }
+                continue;
+            }
 
-                auto pixel_color   = shader.fragmentShader(frag_pos, frag_normal, frag_texcoord);
+#ifdef RASTER_USE_SSE
+            // partially covered block: test 4 pixels of a row at once
+            const __m128 lane = _mm_setr_ps(0.f, 1.f, 2.f, 3.f);
+            const __m128 zero = _mm_setzero_ps();
+            __m128 step[3];
+            for (int i = 0; i < 3; i++)
+                step[i] = _mm_set1_ps(edges[i].a * 4.f);
+            for (int r = by0; r <= by1; r++)
+            {
+                __m128 f[3];
+                for (int i = 0; i < 3; i++)
+                    f[i] = _mm_add_ps(_mm_set1_ps(edges[i].eval(bx0 + 0.5f, r + 0.5f)),
+                                      _mm_mul_ps(lane, _mm_set1_ps(edges[i].a)));
+                for (int c = bx0; c <= bx1; c += 4)
+                {
+                    __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(f[0], zero), _mm_cmpge_ps(f[1], zero)),
+                                               _mm_cmpge_ps(f[2], zero));
+                    int mask = _mm_movemask_ps(inside) & ((1 << std::min(4, bx1 - c + 1)) - 1);
+                    if (mask)
+                    {
+                        alignas(16) float alpha[4], beta[4], gamma[4];
+                        _mm_store_ps(alpha, f[0]);
+                        _mm_store_ps(beta, f[1]);
+                        _mm_store_ps(gamma, f[2]);
+                        for (int k = 0; k < 4; k++)
+                        {
+                            if (mask & (1 << k))
+                                func(c + k, r, alpha[k], beta[k], gamma[k]);
+                        }
+                    }
+                    for (int i = 0; i < 3; i++)
+                        f[i] = _mm_add_ps(f[i], step[i]);
+                }
+            }
+#else
+            for (int r = by0; r <= by1; r++)
+            {
+                float f0 = edges[0].eval(bx0 + 0.5f, r + 0.5f);
+                float f1 = edges[1].eval(bx0 + 0.5f, r + 0.5f);
+                float f2 = edges[2].eval(bx0 + 0.5f, r + 0.5f);
+                for (int c = bx0; c <= bx1; c++)
+                {
+                    if (f0 >= 0.f && f1 >= 0.f && f2 >= 0.f)
+                        func(c, r, f0, f1, f2);
+                    f0 += edges[0].a;
+                    f1 += edges[1].a;
+                    f2 += edges[2].a;
+                }
+            }
+#endif
+        }
+    }
+    return true;
+}
+} // namespace
 
-                gammaAdjust(pixel_color);
+bool Rasterizer::rasterTriangle(Triangle &triangle,const IShader &shader, Image<color4b> &pixels, ZBuffer &zBuffer)
+{
+    //[-1,1] -> [0.5,w-0.5]
+    viewportTransform(triangle, pixels.width(), pixels.height());
 
-                pixels(c, pixels.height() - 1 - r) = pixel_color;
+    int min_x, min_y, max_x, max_y;
+    triangleBoundBox(triangle, min_x, min_y, max_x, max_y, pixels.width(), pixels.height());
 
-                zBuffer.updateZBuffer(c, r, frag_z);
-            }
+    return rasterTriangle(triangle, shader, pixels, zBuffer, min_x, min_y, max_x, max_y);
+}
+
+bool Rasterizer::rasterTriangle(const Triangle &triangle, const IShader &shader, Image<color4b> &pixels, ZBuffer &zBuffer,
+                                int xMin, int yMin, int xMax, int yMax)
+{
+    const auto &v = triangle.vertices;
+    FragmentQueue fragments(pixels);
+    bool drawn = traverseTriangle(triangle, pixels.width(), pixels.height(), zBuffer, xMin, yMin, xMax, yMax,
+                                  [&](int c, int r, float alpha, float beta, float gamma) {
+        auto inv_weight = 1.f / (alpha + beta + gamma);
+        float frag_z = interpolate(alpha, beta, gamma,
+                                   v[0].gl_Position.z, v[1].gl_Position.z, v[2].gl_Position.z, inv_weight);
+        if (zBuffer.zTest(c, r, frag_z))
+        {
+            fragments.push(shader, c, r, triangle, alpha * inv_weight, beta * inv_weight, gamma * inv_weight);
+
+            zBuffer.updateZBuffer(c, r, frag_z);
         }
+    });
+    fragments.flush();
+    return drawn;
+}
+
+bool Rasterizer::rasterVisibility(const Triangle &triangle, uint32_t drawID, uint32_t triangleID,
+                                  Image<Visibility> &visibility, ZBuffer &zBuffer,
+                                  int xMin, int yMin, int xMax, int yMax)
+{
+    const auto &v = triangle.vertices;
+    return traverseTriangle(triangle, visibility.width(), visibility.height(), zBuffer, xMin, yMin, xMax, yMax,
+                            [&](int c, int r, float alpha, float beta, float gamma) {
+        auto inv_weight = 1.f / (alpha + beta + gamma);
+        float frag_z = interpolate(alpha, beta, gamma,
+                                   v[0].gl_Position.z, v[1].gl_Position.z, v[2].gl_Position.z, inv_weight);
+        if (zBuffer.zTest(c, r, frag_z))
+        {
+            visibility(c, r) = Visibility{drawID + 1, triangleID, beta * inv_weight, gamma * inv_weight};
+
+            zBuffer.updateZBuffer(c, r, frag_z);
+        }
+    });
+}
+
+void FragmentQueue::push(const IShader &fragment_shader, int x, int y, const Triangle &triangle, float alpha,
+                         float beta, float gamma)
+{
+    if (shader != &fragment_shader)
+    {
+        flush();
+        shader = &fragment_shader;
     }
-    return true;
+
+    const auto &v = triangle.vertices;
+    auto frag_pos      = alpha * v[0].pos + beta * v[1].pos + gamma * v[2].pos;
+    auto frag_normal   = alpha * v[0].normal + beta * v[1].normal + gamma * v[2].normal;
+    auto frag_texcoord = alpha * v[0].tex_coord + beta * v[1].tex_coord + gamma * v[2].tex_coord;
+
+    packet.pos_x[count]    = frag_pos.x;
+    packet.pos_y[count]    = frag_pos.y;
+    packet.pos_z[count]    = frag_pos.z;
+    packet.normal_x[count] = frag_normal.x;
+    packet.normal_y[count] = frag_normal.y;
+    packet.normal_z[count] = frag_normal.z;
+    packet.u[count]        = frag_texcoord.x;
+    packet.v[count]        = frag_texcoord.y;
+
+    if (quad_triangle != &triangle || quad_x != (x & ~1) || quad_y != (y & ~1))
+        computeQuadDerivatives(triangle, x, y);
+    packet.du_dx[count] = quad_du_dx;
+    packet.dv_dx[count] = quad_dv_dx;
+    packet.du_dy[count] = quad_du_dy;
+    packet.dv_dy[count] = quad_dv_dy;
+    xs[count] = x;
+    ys[count] = y;
+
+    if (++count == FragmentPacket::Size)
+        flush();
+}
+
+void FragmentQueue::flush()
+{
+    if (count == 0)
+        return;
+
+    packet.mask = (1u << count) - 1;
+    for (int i = count; i < FragmentPacket::Size; i++)
+    {
+        packet.pos_x[i]    = packet.pos_x[0];
+        packet.pos_y[i]    = packet.pos_y[0];
+        packet.pos_z[i]    = packet.pos_z[0];
+        packet.normal_x[i] = packet.normal_x[0];
+        packet.normal_y[i] = packet.normal_y[0];
+        packet.normal_z[i] = packet.normal_z[0];
+        packet.u[i]        = packet.u[0];
+        packet.v[i]        = packet.v[0];
+        packet.du_dx[i]    = packet.du_dx[0];
+        packet.dv_dx[i]    = packet.dv_dx[0];
+        packet.du_dy[i]    = packet.du_dy[0];
+        packet.dv_dy[i]    = packet.dv_dy[0];
+    }
+
+    shader->fragmentShader(packet);
+
+    for (int i = 0; i < count; i++)
+    {
+        auto pixel_color = packet.color[i];
+        Rasterizer::gammaAdjust(pixel_color);
+        pixels(xs[i], pixels.height() - 1 - ys[i]) = pixel_color;
+    }
+    count = 0;
+}
+
+void FragmentQueue::computeQuadDerivatives(const Triangle &triangle, int x, int y)
+{
+    quad_triangle = &triangle;
+    quad_x        = x & ~1;
+    quad_y        = y & ~1;
+
+    const auto &v = triangle.vertices;
+    auto tex_coord_at = [&](float px, float py) {
+        auto [alpha, beta, gamma] = Rasterizer::computeBarycentric2D(px, py, triangle);
+        auto inv_weight = 1.f / (alpha + beta + gamma);
+        return (alpha * v[0].tex_coord + beta * v[1].tex_coord + gamma * v[2].tex_coord) * inv_weight;
+    };
+    const float2 t00 = tex_coord_at(quad_x + 0.5f, quad_y + 0.5f);
+    const float2 t10 = tex_coord_at(quad_x + 1.5f, quad_y + 0.5f);
+    const float2 t01 = tex_coord_at(quad_x + 0.5f, quad_y + 1.5f);
+    quad_du_dx = t10.x - t00.x;
+    quad_dv_dx = t10.y - t00.y;
+    quad_du_dy = t01.x - t00.x;
+    quad_dv_dy = t01.y - t00.y;
 }
 
 void Rasterizer::triangleBoundBox(const Triangle &triangle, int &xMin, int &yMin, int &xMax, int &yMax, int w, int h)
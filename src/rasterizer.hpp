@@ -3,13 +3,76 @@
 #include "shader.hpp"
 #include "zbuffer.hpp"
 
+// what deferred shading needs to reconstruct the fragment of a pixel
+struct Visibility
+{
+    // 0 means no triangle covers the pixel, otherwise draw index + 1
+    uint32_t draw;
+    uint32_t triangle;
+    // perspective corrected barycentric coordinates, alpha = 1 - beta - gamma
+    float beta, gamma;
+};
+
+// fragments waiting to be shaded together as one FragmentPacket, written into pixels when it is shaded
+// pixels of a queue should not overlap until flush, which holds within a triangle and within a resolve row
+class FragmentQueue
+{
+  public:
+    explicit FragmentQueue(Image<color4b> &pixels) : pixels(pixels)
+    {
+    }
+
+    FragmentQueue(const FragmentQueue &) = delete;
+
+    FragmentQueue &operator=(const FragmentQueue &) = delete;
+
+    // attributes of pixel (x, y) are interpolated with normalized barycentric coordinates
+    void push(const IShader &shader, int x, int y, const Triangle &triangle, float alpha, float beta, float gamma);
+
+    // shade pending fragments, should be called before pixels are read
+    void flush();
+
+  private:
+    // texture coordinate derivatives by finite differences of the 2x2 quad containing pixel (x, y),
+    // triangle is evaluated on all pixel centers of the quad even if some are not covered
+    void computeQuadDerivatives(const Triangle &triangle, int x, int y);
+
+    Image<color4b> &pixels;
+    const IShader *shader = nullptr;
+    FragmentPacket packet;
+    int count = 0;
+    int xs[FragmentPacket::Size];
+    int ys[FragmentPacket::Size];
+
+    // derivatives are shared by fragments of the last quad
+    const Triangle *quad_triangle = nullptr;
+    int quad_x = -1;
+    int quad_y = -1;
+    float quad_du_dx = 0.f;
+    float quad_dv_dx = 0.f;
+    float quad_du_dy = 0.f;
+    float quad_dv_dy = 0.f;
+};
+
 class Rasterizer
 {
   public:
     Rasterizer() = delete;
 
+    // pixels are tested against edges in BlockSize x BlockSize blocks first
+    static constexpr int BlockSize = 8;
+
     static bool rasterTriangle(Triangle &triangle,const IShader &shader, Image<color4b> &pixels, ZBuffer &zBuffer);
 
+    // triangle should be already in screen space and only pixels inside [xMin,xMax]x[yMin,yMax] will be touched
+    static bool rasterTriangle(const Triangle &triangle, const IShader &shader, Image<color4b> &pixels, ZBuffer &zBuffer,
+                               int xMin, int yMin, int xMax, int yMax);
+
+    // depth pass of deferred shading which only records the visible triangle and its barycentric coordinates
+    static bool rasterVisibility(const Triangle &triangle, uint32_t drawID, uint32_t triangleID,
+                                 Image<Visibility> &visibility, ZBuffer &zBuffer,
+                                 int xMin, int yMin, int xMax, int yMax);
+
     static void triangleBoundBox(const Triangle &triangle, int &xMin, int &yMin, int &xMax, int &yMax, int w, int h);
 
     static std::tuple<float, float, float> computeBarycentric2D(float x, float y, const Triangle &triangle);
@@ -8,6 +8,9 @@
 #include "rasterizer.hpp"
 #include "shader.hpp"
 #include "model.hpp"
+#include "util.hpp"
+
+bool use_deferred = false;
 
 SoftRenderer::SoftRenderer(const std::shared_ptr<Scene> &scene) : scene(scene)
 {
@@ -16,61 +19,256 @@ SoftRenderer::SoftRenderer(const std::shared_ptr<Scene> &scene) : scene(scene)
 
 void SoftRenderer::render(const IShader &shader,const Model& model,bool clip)
 {
-    int triangle_count = model.getMesh()->triangles.size();
+    const auto& mesh = *model.getMesh();
+    const auto indices = mesh.indices();
+    int triangle_count = mesh.triangleCount();
+    int vertex_count = mesh.vertexCount();
+
+    LOG_DEBUG("render model triangle count: {}, vertex count: {}",triangle_count,vertex_count);
+
+    Timer timer;
+    timer.start();
+    cullClusters(shader, mesh);
+    timer.stop();
+    stats.cull += timer.duration().ms().count();
 
-    LOG_DEBUG("render model triangle count: {}",triangle_count);
+    const auto clusters = mesh.clusters();
+    const int w = pixels.width();
+    const int h = pixels.height();
+    const int tile_count = tile_num_x * tile_num_y;
+    const int batch_count = static_cast<int>(batch_clusters.size()) - 1;
+    const int vertex_batch_count = static_cast<int>(vertex_jobs.size());
+
+    // deferred draws keep their primitives until resolve
+    uint32_t draw_id = 0;
+    auto *draw_primitives = &primitives;
+    if (use_deferred)
+    {
+        if (deferred_draw_count == static_cast<int>(deferred_draws.size()))
+            deferred_draws.emplace_back();
+        draw_id = deferred_draw_count++;
+        deferred_draws[draw_id].shader = &shader;
+        draw_primitives = &deferred_draws[draw_id].primitives;
+    }
+    auto &prims = *draw_primitives;
+    prims.resize(triangle_count);
+    if (static_cast<int>(tile_bins.size()) < batch_count)
+    {
+        tile_bins.resize(batch_count);
+        clipped_primitives.resize(batch_count);
+    }
+    for (int b = 0; b < batch_count; b++)
+    {
+        tile_bins[b].resize(tile_count);
+        for (auto &bin : tile_bins[b])
+            bin.clear();
+        clipped_primitives[b].clear();
+    }
 #ifndef NDEBUG
     std::atomic<int> raster_count = 0;
 #endif
-#ifndef USE_OMP
-    parallel_forrange(0,triangle_count,[&](int,int i){
-        const auto &triangle = model.getMesh()->triangles[i];
+    // phase 0: every unique vertex of visible clusters is transformed only once and shared by triangles
+    // through the index buffer
+    transformed_vertices.resize(vertex_count);
+    auto transform_batch = [&](int batch){
+        int beg = vertex_jobs[batch].first;
+        int end = vertex_jobs[batch].second;
+        shader.vertexShader(mesh, beg, end, transformed_vertices.data() + beg);
+    };
 
-        if (backFaceCulling(triangle, model.getModelMatrix()))
-            return;
+    // phase 1: assemble triangles of visible clusters from transformed vertices and bin them into screen tiles
+    // every batch owns its bins so no synchronization is needed and the order of triangles is kept
+    auto bin_batch = [&](int batch){
+        auto& bins = tile_bins[batch];
+        auto& clipped = clipped_primitives[batch];
+        auto bin_triangle = [&](Triangle &triangle, uint32_t index){
+            triangle.Homogenization();
 
-        auto triangle_primitive = shader.vertexShader(triangle);
-
-        if (clip && clipTriangle(triangle_primitive))
-            return;
+            Rasterizer::viewportTransform(triangle, w, h);
 
-        triangle_primitive.Homogenization();
+            int min_x, min_y, max_x, max_y;
+            Rasterizer::triangleBoundBox(triangle, min_x, min_y, max_x, max_y, w, h);
+            if (min_x > max_x || min_y > max_y)
+                return;
 
-        bool r = Rasterizer::rasterTriangle(triangle_primitive, shader, pixels, *z_buffer);
+            for (int ty = min_y / TileSize; ty <= max_y / TileSize; ty++)
+            {
+                for (int tx = min_x / TileSize; tx <= max_x / TileSize; tx++)
+                {
+                    bins[ty * tile_num_x + tx].emplace_back(index);
+                }
+            }
 #ifndef NDEBUG
-        if (r)
             raster_count++;
 #endif
-    });
-#else
-#pragma omp parallel for schedule(dynamic)
-    for (int i = 0; i < triangle_count; i++)
-    {
-        const auto &triangle = model.getMesh()->triangles[i];
+        };
+        Triangle extra[MaxClippedTriangles - 1];
+        for (int v = batch_clusters[batch]; v < batch_clusters[batch + 1]; v++)
+        {
+            const auto &cluster = clusters[visible_clusters[v]];
+            const int beg = static_cast<int>(cluster.first_triangle);
+            const int end = beg + static_cast<int>(cluster.triangle_count);
+            for (int i = beg; i < end; i++)
+            {
+                const uint32_t *index = &indices[i * 3];
 
-        if (backFaceCulling(triangle, model.getModelMatrix()))
-            continue;
+                auto& triangle_primitive = prims[i];
+                for (int k = 0; k < 3; k++)
+                {
+                    triangle_primitive.vertices[k] = transformed_vertices[index[k]];
+                }
 
-        auto triangle_primitive = shader.vertexShader(triangle);
+                if (backFaceCulling(triangle_primitive))
+                    continue;
 
-        if (clip && clipTriangle(triangle_primitive))
-            continue;
+                int count = clip ? clipTriangle(triangle_primitive, extra) : 1;
+                if (count == 0)
+                    continue;
 
-        triangle_primitive.Homogenization();
+                bin_triangle(triangle_primitive, i);
+                for (int k = 1; k < count; k++)
+                {
+                    bin_triangle(extra[k - 1], triangle_count + static_cast<uint32_t>(clipped.size()));
+                    clipped.emplace_back(extra[k - 1]);
+                }
+            }
+        }
+    };
 
-        bool r = Rasterizer::rasterTriangle(triangle_primitive, shader, pixels, *z_buffer);
-#ifndef NDEBUG
-        if (r)
-            raster_count++;
+    // triangles of clipping are appended to primitives behind the mesh triangles batch by batch,
+    // clipped_base[batch] is where those of batch start
+    std::vector<uint32_t> clipped_base(batch_count);
+    auto append_clipped = [&](){
+        size_t size = triangle_count;
+        for (int b = 0; b < batch_count; b++)
+        {
+            clipped_base[b] = static_cast<uint32_t>(size);
+            size += clipped_primitives[b].size();
+        }
+        if (size == static_cast<size_t>(triangle_count))
+            return;
+        prims.resize(size);
+        for (int b = 0; b < batch_count; b++)
+        {
+            std::copy(clipped_primitives[b].begin(), clipped_primitives[b].end(), prims.begin() + clipped_base[b]);
+        }
+    };
+
+    // phase 2: every tile is owned by one worker which rasterizes all triangles binned to it
+    // so writes to pixels and z-buffer never race
+    auto raster_tile = [&](int tile){
+        int tx = tile % tile_num_x;
+        int ty = tile / tile_num_x;
+        int min_x = tx * TileSize;
+        int min_y = ty * TileSize;
+        int max_x = std::min(min_x + TileSize, w) - 1;
+        int max_y = std::min(min_y + TileSize, h) - 1;
+        for (int b = 0; b < batch_count; b++)
+        {
+            for (auto i : tile_bins[b][tile])
+            {
+                if (i >= static_cast<uint32_t>(triangle_count))
+                    i = clipped_base[b] + (i - triangle_count);
+                if (use_deferred)
+                    Rasterizer::rasterVisibility(prims[i], draw_id, i, visibility, *z_buffer, min_x, min_y, max_x, max_y);
+                else
+                    Rasterizer::rasterTriangle(prims[i], shader, pixels, *z_buffer, min_x, min_y, max_x, max_y);
+            }
+            // hierarchical zbuffer is refreshed once per batch instead of per fragment
+            z_buffer->updateHierarchy(min_x, min_y, max_x, max_y);
+        }
+    };
+
+    timer.start();
+#ifndef USE_OMP
+    parallel_for(0,vertex_batch_count,[&](int batch){
+        transform_batch(batch);
+    },1);
+#else
+#pragma omp parallel for schedule(dynamic)
+    for (int batch = 0; batch < vertex_batch_count; batch++)
+    {
+        transform_batch(batch);
+    }
+#endif
+    timer.stop();
+    stats.vertex += timer.duration().ms().count();
+
+    timer.start();
+#ifndef USE_OMP
+    parallel_for(0,batch_count,[&](int batch){
+        bin_batch(batch);
+    },1);
+#else
+#pragma omp parallel for schedule(dynamic)
+    for (int batch = 0; batch < batch_count; batch++)
+    {
+        bin_batch(batch);
+    }
 #endif
+    append_clipped();
+    timer.stop();
+    stats.cull += timer.duration().ms().count();
+
+    timer.start();
+#ifndef USE_OMP
+    parallel_for(0,tile_count,[&](int tile){
+        raster_tile(tile);
+    },1);
+#else
+#pragma omp parallel for schedule(dynamic)
+    for (int tile = 0; tile < tile_count; tile++)
+    {
+        raster_tile(tile);
     }
 #endif
+    timer.stop();
+    stats.raster += timer.duration().ms().count();
 
 #ifndef NDEBUG
     LOG_DEBUG("raster triangle count: {}",raster_count);
 #endif
 
 }
+void SoftRenderer::resolve()
+{
+    if (!use_deferred)
+        return;
+
+    Timer timer;
+    timer.start();
+    const int w = visibility.width();
+    const int h = visibility.height();
+    // covered pixels of a row are packed into fragment packets, switching draw only flushes a partial one
+    auto shade_row = [&](int r){
+        FragmentQueue fragments(pixels);
+        for (int c = 0; c < w; c++)
+        {
+            const auto &vis = visibility(c, r);
+            if (!vis.draw)
+                continue;
+            const auto &draw = deferred_draws[vis.draw - 1];
+            fragments.push(*draw.shader, c, r, draw.primitives[vis.triangle], 1.f - vis.beta - vis.gamma, vis.beta,
+                           vis.gamma);
+        }
+        fragments.flush();
+    };
+
+#ifndef USE_OMP
+    parallel_for(0,h,[&](int r){
+        shade_row(r);
+    });
+#else
+#pragma omp parallel for schedule(dynamic)
+    for (int r = 0; r < h; r++)
+    {
+        shade_row(r);
+    }
+#endif
+    timer.stop();
+    stats.shade += timer.duration().ms().count();
+}
+
 void SoftRenderer::render()
 {
     auto models = scene->getVisibleModels();
@@ -79,9 +277,11 @@ void SoftRenderer::render()
         LOG_DEBUG("render models count: {}",models.size());
     }
 
-    for (auto model : models)
+    std::vector<PBRShader> shaders(models.size());
+    for (size_t m = 0; m < models.size(); m++)
     {
-        PBRShader shader;
+        auto model = models[m];
+        auto &shader = shaders[m];
         shader.model        = model->getModelMatrix();
         shader.view         = scene->getCamera()->getViewMatrix();
         shader.projection   = scene->getCamera()->getProjMatrix();
@@ -101,69 +301,253 @@ void SoftRenderer::render()
             shader.lightRadiance[i] = lights[i].light_radiance;
         }
 
-        int triangle_count = model->getMesh()->triangles.size();
-        LOG_DEBUG("render model triangle count: {}",triangle_count);
-#ifndef NDEBUG
-        std::atomic<int> raster_count = 0;
-#endif
-#pragma omp parallel for firstprivate(shader) schedule(dynamic)
-        for (int i = 0; i < triangle_count; i++)
-        {
-            const auto &triangle = model->getMesh()->triangles[i];
+        render(shader, *model, true);
+    }
+    resolve();
+}
 
-            if (backFaceCulling(triangle, shader.model))
-                continue;
+const Image<color4b> &SoftRenderer::getImage() const
+{
+    return pixels;
+}
 
-            auto triangle_primitive = shader.vertexShader(triangle);
+void SoftRenderer::init()
+{
+    createFrameBuffer(ScreenWidth, ScreenHeight);
+}
 
-            if (clipTriangle(triangle_primitive))
-                continue;
+void SoftRenderer::renderBackground(const SkyShader &shader)
+{
+    Timer timer;
+    timer.start();
+    const int w = pixels.width();
+    const int h = pixels.height();
+    const int tile_count = tile_num_x * tile_num_y;
 
-            triangle_primitive.Homogenization();
+    // ray through the far plane point of ndc (x, y) is linear in x and y before division by w,
+    // and inverse of viewport transform maps pixel center c + 0.5 to ndc 2c / w - 1
+    const mat4 inv_view_proj = inverse(shader.projection * mat4(mat3(shader.view)));
+    const float3 ray_origin = float3(inv_view_proj * float4(-1.f, -1.f, 1.f, 1.f));
+    const float3 ray_dx = float3(inv_view_proj * float4(2.f / w, 0.f, 0.f, 0.f));
+    const float3 ray_dy = float3(inv_view_proj * float4(0.f, 2.f / h, 0.f, 0.f));
 
-            bool r = Rasterizer::rasterTriangle(triangle_primitive, shader, pixels, *z_buffer);
-#ifndef NDEBUG
-            if (r)
-                raster_count++;
-#endif
+    // depth of every drawn fragment is at most 1 so only pixels still at clear depth pass a test of 1
+    constexpr float FarDepth = 1.f;
+    auto fill_tile = [&](int tile){
+        int min_x = (tile % tile_num_x) * TileSize;
+        int min_y = (tile / tile_num_x) * TileSize;
+        int max_x = std::min(min_x + TileSize, w) - 1;
+        int max_y = std::min(min_y + TileSize, h) - 1;
+        // hierarchical zbuffer tells tiles entirely covered by models
+        if (!z_buffer->zTest({{(float)min_x, (float)min_y}, {(float)max_x, (float)max_y}}, FarDepth))
+            return;
+        for (int r = min_y; r <= max_y; r++)
+        {
+            float3 ray = ray_origin + static_cast<float>(r) * ray_dy + static_cast<float>(min_x) * ray_dx;
+            for (int c = min_x; c <= max_x; c++, ray += ray_dx)
+            {
+                if (!z_buffer->zTest(c, r, FarDepth))
+                    continue;
+                auto pixel_color = float3_to_color4b(shader.sampleSky(ray));
+                Rasterizer::gammaAdjust(pixel_color);
+                pixels(c, h - 1 - r) = pixel_color;
+            }
         }
-#ifndef NDEBUG
-        LOG_DEBUG("raster triangle count: {}",raster_count);
-#endif
+    };
+
+#ifndef USE_OMP
+    parallel_for(0,tile_count,[&](int tile){
+        fill_tile(tile);
+    },1);
+#else
+#pragma omp parallel for schedule(dynamic)
+    for (int tile = 0; tile < tile_count; tile++)
+    {
+        fill_tile(tile);
     }
+#endif
+    timer.stop();
+    stats.sky += timer.duration().ms().count();
 }
 
-const Image<color4b> &SoftRenderer::getImage() const
+namespace
 {
-    return pixels;
+// every triangle of cluster faces away from eye, its box is bounded by a sphere so no cone apex is needed
+bool ClusterFacesAway(const Mesh::Cluster &cluster, const float3 &eye)
+{
+    const float3 center = (cluster.box.min_p + cluster.box.max_p) * 0.5f;
+    const float radius = length(cluster.box.max_p - center);
+    const float3 to_center = center - eye;
+    return dot(to_center, cluster.cone_axis) >= cluster.cone_cutoff * length(to_center) + radius;
 }
+} // namespace
 
-void SoftRenderer::init()
+void SoftRenderer::cullClusters(const IShader &shader, const Mesh &mesh)
 {
-    createFrameBuffer(ScreenWidth, ScreenHeight);
+    const auto clusters = mesh.clusters();
+    visible_clusters.clear();
+
+    // clusters are tested in model space with the matrices vertex shader uses,
+    // draws of shaders which do not expose them keep every cluster
+    const PBRShader *pbr = shader.asPBRShader();
+    FrustumExt frustum;
+    float3 eye{0.f};
+    bool cone_culling = false;
+    if (pbr)
+    {
+        ExtractViewFrustumPlanesFromMatrix(pbr->MVPMatrix, frustum);
+        eye = inverse(pbr->model) * float4(pbr->viewPos, 1.f);
+        // a mirroring model matrix flips the winding which back face culling sees, but not the cones
+        cone_culling = determinant(mat3(pbr->model)) > 0.f;
+    }
+    for (uint32_t c = 0; c < clusters.size(); c++)
+    {
+        if (pbr && (GetBoxVisibility(frustum, clusters[c].box) == BoxVisibility::Invisible ||
+                    (cone_culling && ClusterFacesAway(clusters[c], eye))))
+            continue;
+        visible_clusters.emplace_back(c);
+    }
+
+    // whole clusters are packed into batches of at most BinBatchSize triangles
+    batch_clusters.clear();
+    int batch_triangles = BinBatchSize;
+    for (int v = 0; v < static_cast<int>(visible_clusters.size()); v++)
+    {
+        const int count = static_cast<int>(clusters[visible_clusters[v]].triangle_count);
+        if (batch_triangles + count > BinBatchSize)
+        {
+            batch_clusters.emplace_back(v);
+            batch_triangles = 0;
+        }
+        batch_triangles += count;
+    }
+    batch_clusters.emplace_back(static_cast<int>(visible_clusters.size()));
+
+    // vertex ranges of neighbouring clusters overlap, they are merged so every vertex is shaded once
+    std::vector<std::pair<int, int>> ranges;
+    ranges.reserve(visible_clusters.size());
+    for (auto c : visible_clusters)
+        ranges.emplace_back(clusters[c].vertex_begin, clusters[c].vertex_end);
+    std::sort(ranges.begin(), ranges.end());
+    vertex_jobs.clear();
+    for (size_t r = 0; r < ranges.size();)
+    {
+        int beg = ranges[r].first;
+        int end = ranges[r].second;
+        for (r++; r < ranges.size() && ranges[r].first <= end; r++)
+            end = std::max(end, ranges[r].second);
+        for (; beg < end; beg += BinBatchSize)
+            vertex_jobs.emplace_back(beg, std::min(beg + BinBatchSize, end));
+    }
+    LOG_DEBUG("visible cluster count: {} / {}", visible_clusters.size(), clusters.size());
+}
+
+bool SoftRenderer::backFaceCulling(const Triangle &triangle) const
+{
+    // determinant of (x, y, w) rows is the signed volume spanned by the eye and the triangle,
+    // it has the sign of screen space area when all w > 0 and needs no division
+    const auto &p0 = triangle.vertices[0].gl_Position;
+    const auto &p1 = triangle.vertices[1].gl_Position;
+    const auto &p2 = triangle.vertices[2].gl_Position;
+    float det = p0.x * (p1.y * p2.w - p2.y * p1.w) - p1.x * (p0.y * p2.w - p2.y * p0.w) +
+                p2.x * (p0.y * p1.w - p1.y * p0.w);
+    return det <= 0.f;
 }
 
-bool SoftRenderer::backFaceCulling(const Triangle &triangle, mat4 modelMatrix) const
+namespace
 {
-    float3 e1 = normalize(triangle.vertices[1].pos - triangle.vertices[0].pos);
-    float3 e2 = normalize(triangle.vertices[2].pos - triangle.vertices[1].pos);
-    float3 face_normal = cross(e1, e2);
-    face_normal = modelMatrix * float4(face_normal, 0.f);
-    return dot(scene->getCamera()->front, face_normal) > 0.0001f;
+// vertex is inside if dot(coeff, gl_Position) >= offset
+struct ClipPlane
+{
+    float4 coeff;
+    float offset;
+};
+
+// w plane keeps vertices away from the eye so a triangle crossing the eye plane never gets w == 0
+constexpr float MinClipW = 1e-5f;
+
+const ClipPlane ClipPlanes[SoftRenderer::ClipPlaneCount] = {
+    {{0.f, 0.f, 0.f, 1.f}, MinClipW},
+    // z should in (0,1) for camera at origin
+    {{0.f, 0.f, 1.f, 0.f}, 0.f},
+    {{0.f, 0.f, -1.f, 1.f}, 0.f},
+    {{1.f, 0.f, 0.f, SoftRenderer::GuardBand}, 0.f},
+    {{-1.f, 0.f, 0.f, SoftRenderer::GuardBand}, 0.f},
+    {{0.f, 1.f, 0.f, SoftRenderer::GuardBand}, 0.f},
+    {{0.f, -1.f, 0.f, SoftRenderer::GuardBand}, 0.f},
+};
+
+Triangle::Vertex LerpVertex(const Triangle::Vertex &a, const Triangle::Vertex &b, float t)
+{
+    return {mix(a.gl_Position, b.gl_Position, t), mix(a.pos, b.pos, t), mix(a.normal, b.normal, t),
+            mix(a.tex_coord, b.tex_coord, t)};
 }
+} // namespace
 
-bool SoftRenderer::clipTriangle(const Triangle &triangle) const
+int SoftRenderer::clipTriangle(Triangle &triangle, Triangle *extra) const
 {
-    int outside_count = 0;
+    constexpr int MaxPolygonSize = 3 + ClipPlaneCount;
+
+    // bit p of outside[i] is set if vertex i is outside plane p
+    uint32_t outside[3] = {0, 0, 0};
     for (int i = 0; i < 3; i++)
     {
         const auto &v = triangle.vertices[i].gl_Position;
-        bool inside = (-v.w <= v.x && v.x <= v.w) && (-v.w <= v.y && v.y <= v.w) &&
-                      (0.f <= v.z && v.z <= v.w); // z should in (0,1) for camera at origin
-        if (!inside)
-            outside_count++;
+        for (int p = 0; p < ClipPlaneCount; p++)
+        {
+            if (dot(ClipPlanes[p].coeff, v) < ClipPlanes[p].offset)
+                outside[i] |= 1u << p;
+        }
     }
-    return outside_count == 3;
+    if (outside[0] & outside[1] & outside[2])
+        return 0;
+    const uint32_t crossing = outside[0] | outside[1] | outside[2];
+    if (!crossing)
+        return 1;
+
+    // Sutherland-Hodgman against every crossed plane, the polygon is kept convex and in order
+    Triangle::Vertex polygon[2][MaxPolygonSize];
+    int size = 3;
+    int cur = 0;
+    for (int i = 0; i < 3; i++)
+        polygon[cur][i] = triangle.vertices[i];
+    for (int p = 0; p < ClipPlaneCount && size > 0; p++)
+    {
+        if (!(crossing & (1u << p)))
+            continue;
+        const auto &plane = ClipPlanes[p];
+        const auto *in = polygon[cur];
+        auto *out = polygon[cur ^ 1];
+        int out_size = 0;
+        for (int i = 0; i < size; i++)
+        {
+            const auto &a = in[i];
+            const auto &b = in[(i + 1) % size];
+            float da = dot(plane.coeff, a.gl_Position) - plane.offset;
+            float db = dot(plane.coeff, b.gl_Position) - plane.offset;
+            if (da >= 0.f)
+                out[out_size++] = a;
+            if ((da >= 0.f) != (db >= 0.f))
+                out[out_size++] = LerpVertex(a, b, da / (da - db));
+        }
+        size = out_size;
+        cur ^= 1;
+    }
+    if (size < 3)
+        return 0;
+
+    // fan keeps the winding of the original triangle
+    const auto *result = polygon[cur];
+    triangle.vertices[0] = result[0];
+    triangle.vertices[1] = result[1];
+    triangle.vertices[2] = result[2];
+    for (int i = 3; i < size; i++)
+    {
+        extra[i - 3].vertices[0] = result[0];
+        extra[i - 3].vertices[1] = result[i - 1];
+        extra[i - 3].vertices[2] = result[i];
+    }
+    return size - 2;
 }
 
 bool use_hz = false;
@@ -171,8 +555,14 @@ bool use_hz = false;
 void SoftRenderer::createFrameBuffer(int w, int h)
 {
     pixels = Image<color4b>(w, h);
+    tile_num_x = (w + TileSize - 1) / TileSize;
+    tile_num_y = (h + TileSize - 1) / TileSize;
+    if(use_deferred){
+        visibility = Image<Visibility>(w, h);
+        LOG_INFO("create visibility buffer for deferred shading");
+    }
     if(use_hz){
-        z_buffer = std::make_unique<HierarchicalZBuffer>(w, h);
+        z_buffer = std::make_unique<HierarchicalZBuffer>(w, h, TileSize);
         LOG_INFO("create hierarchical zbuffer");
     }
     else{
@@ -183,7 +573,25 @@ void SoftRenderer::createFrameBuffer(int w, int h)
 
 void SoftRenderer::clearFrameBuffer()
 {
+    Timer timer;
+    timer.start();
     pixels.clear();
     z_buffer->clear();
+    if (use_deferred)
+    {
+        visibility.clear();
+        deferred_draw_count = 0;
+    }
+    timer.stop();
+    stats.clear += timer.duration().ms().count();
+}
+
+RenderStats &SoftRenderer::getStats()
+{
+    return stats;
 }
 
+void SoftRenderer::resetStats()
+{
+    stats = RenderStats{};
+}
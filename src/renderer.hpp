@@ -2,36 +2,124 @@
 
 #include "common.hpp"
 #include "scene.hpp"
+#include "rasterizer.hpp"
 #include "zbuffer.hpp"
 
+// accumulated cost of every pipeline stage in milliseconds since last resetStats
+struct RenderStats
+{
+    double clear  = 0.0;
+    // frustum culling of models and clusters, triangle assembly, back face culling, clipping and binning
+    double cull   = 0.0;
+    double vertex = 0.0;
+    // fragment shading is done here too if deferred shading is off
+    double raster = 0.0;
+    // resolve of visibility buffer
+    double shade  = 0.0;
+    // sky filled into pixels no model covers
+    double sky    = 0.0;
+};
+
 class SoftRenderer
 {
   public:
+    // screen is split into TileSize x TileSize tiles and each tile is rasterized by only one worker
+    static constexpr int TileSize = 64;
+
+    // vertices are transformed and triangles are binned in batches of this size
+    static constexpr int BinBatchSize = 1024;
+
+    // x and y in [-GuardBand * w, GuardBand * w] are left to the rasterizer instead of being clipped
+    static constexpr float GuardBand = 16.f;
+
+    // w plane, near, far and four guard band planes add at most one vertex each to the polygon
+    static constexpr int ClipPlaneCount = 7;
+    static constexpr int MaxClippedTriangles = ClipPlaneCount + 1;
+
     explicit SoftRenderer(const std::shared_ptr<Scene> &scene);
 
     [[deprecated]] void render();
 
+    // with deferred shading on, shader is only referenced and must stay alive until resolve
     void render(const IShader& shader,const Model& model,bool clip = false);
 
+    // shade every visible pixel of the visibility buffer once if deferred shading is on, otherwise do nothing
+    void resolve();
+
+    // fill pixels left at clear depth by the draws of this frame with sky seen along their view rays,
+    // so its cost follows the visible sky area instead of sky geometry
+    void renderBackground(const SkyShader& shader);
+
     const Image<color4b> &getImage() const;
 
-    bool backFaceCulling(const Triangle &triangle, mat4 modelMatrix) const;
+    // vertices of triangle are in clip space, the test holds for vertices behind the eye too
+    bool backFaceCulling(const Triangle &triangle) const;
 
-    bool clipTriangle(const Triangle &triangle) const;
+    // clip triangle in clip space against near and far planes, and against the guard band only if it
+    // leaves the band, the result is a fan of 0..MaxClippedTriangles triangles with triangle replaced
+    // by the first one and the others written to extra, returns the triangle count
+    int clipTriangle(Triangle &triangle, Triangle *extra) const;
 
     void clearFrameBuffer();
 
     void createFrameBuffer(int w, int h);
 
+    RenderStats &getStats();
+
+    void resetStats();
+
   private:
 
     void init();
 
+    // drop clusters of mesh outside the frustum or facing away, then pack the rest into triangle batches
+    // and the vertices they reference into vertex jobs
+    void cullClusters(const IShader &shader, const Mesh &mesh);
+
   private:
 
     RC<Scene> scene;
 
+    // vertex shader outputs of the model being rendered, indexed by mesh vertex index
+    std::vector<Triangle::Vertex> transformed_vertices;
+
+    // indices of clusters of the model being rendered which survive culling
+    std::vector<uint32_t> visible_clusters;
+
+    // batch b bins triangles of visible_clusters[batch_clusters[b], batch_clusters[b + 1])
+    std::vector<int> batch_clusters;
+
+    // [beg, end) of vertices referenced by visible clusters, at most BinBatchSize each
+    std::vector<std::pair<int, int>> vertex_jobs;
+
+    // screen space triangles of the model being rendered, indexed by mesh triangle index
+    std::vector<Triangle> primitives;
+
+    // triangle indices binned to each tile: tile_bins[batch][tile]
+    std::vector<std::vector<std::vector<uint32_t>>> tile_bins;
+
+    // triangles except the first one produced by clipping in each batch, they are appended to
+    // primitives after binning and indexed as triangle count + position in batch until then
+    std::vector<std::vector<Triangle>> clipped_primitives;
+
+    int tile_num_x = 0;
+    int tile_num_y = 0;
+
+    struct DeferredDraw
+    {
+        const IShader *shader;
+        std::vector<Triangle> primitives;
+    };
+
+    // draws recorded in this frame for deferred shading, only the first deferred_draw_count are valid
+    std::vector<DeferredDraw> deferred_draws;
+    int deferred_draw_count = 0;
+
+    Image<Visibility> visibility;
+
     Image<color4b> pixels;
 
     Box<ZBuffer> z_buffer;
+
+    RenderStats stats;
 };
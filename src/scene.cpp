@@ -4,6 +4,9 @@
 #include <iostream>
 
 #include "scene.hpp"
+#include "asset_manager.hpp"
+#include "parallel.hpp"
+#include "util.hpp"
 
 #include <json.hpp>
 
@@ -79,6 +82,7 @@ void Scene::setCamera(const Camera &camera)
 void Scene::clearModels()
 {
     this->models.clear();
+    AssetManager::getInstance().purge();
 }
 
 void Scene::clearScene()
@@ -87,6 +91,26 @@ void Scene::clearScene()
     clearLights();
 }
 
+void Scene::replaceWith(Scene &&loaded)
+{
+    models = std::move(loaded.models);
+    lights = std::move(loaded.lights);
+    if (loaded.skybox)
+        skybox = std::move(loaded.skybox);
+    AssetManager::getInstance().purge();
+}
+
+void Scene::replaceSkyBox(Scene &&loaded)
+{
+    if (loaded.skybox)
+        skybox = std::move(loaded.skybox);
+}
+
+void Scene::clearSkyBox()
+{
+    this->skybox.reset();
+}
+
 void Scene::clearLights()
 {
     this->lights.clear();
@@ -107,7 +131,7 @@ void Scene::addLight(const Light &light)
     this->lights.emplace_back(light);
 }
 
-void Scene::loadScene(const std::string &filename)
+void Scene::loadScene(const std::string &filename, LoadProgress *progress)
 {
     std::ifstream in(filename);
     if (!in.is_open())
@@ -118,24 +142,38 @@ void Scene::loadScene(const std::string &filename)
     in >> j;
     in.close();
     int model_count = j.at("model_count");
+
+    // every mesh, texture and the environment map with its IBL is one job of the task group,
+    // jobs only write their own member of their own model so they need no lock
+    std::vector<Model> load_models(model_count);
+    TaskGroup group;
+    auto spawn = [&](auto job) {
+        if (progress)
+            progress->total++;
+        group.run([job, progress] {
+            job();
+            if (progress)
+                progress->done++;
+        });
+    };
     for (int i = 0; i < model_count; i++)
     {
         auto name = "model_" + std::to_string(i + 1);
         auto model = j.at(name);
-        auto mesh_path = model.at("mesh");
-        auto albedo_path = model.at("albedo");
-        auto normal_path = model.at("normal");
-        auto ambient_path = model.at("ambient");
-        auto roughness_path = model.at("roughness");
-        auto metallic_path = model.at("metallic");
-
-        Model load_model;
-        load_model.loadMesh(mesh_path);
-        load_model.loadAlbedoMap(albedo_path);
-        load_model.loadNormalMap(normal_path);
-        load_model.loadAOMap(ambient_path);
-        load_model.loadRoughnessMap(roughness_path);
-        load_model.loadMetallicMap(metallic_path);
+        std::string mesh_path = model.at("mesh");
+        std::string albedo_path = model.at("albedo");
+        std::string normal_path = model.at("normal");
+        std::string ambient_path = model.at("ambient");
+        std::string roughness_path = model.at("roughness");
+        std::string metallic_path = model.at("metallic");
+
+        auto &load_model = load_models[i];
+        spawn([&load_model, mesh_path] { load_model.loadMesh(mesh_path); });
+        spawn([&load_model, albedo_path] { load_model.loadAlbedoMap(albedo_path); });
+        spawn([&load_model, normal_path] { load_model.loadNormalMap(normal_path); });
+        spawn([&load_model, ambient_path] { load_model.loadAOMap(ambient_path); });
+        spawn([&load_model, roughness_path] { load_model.loadRoughnessMap(roughness_path); });
+        spawn([&load_model, metallic_path] { load_model.loadMetallicMap(metallic_path); });
 
         if (model.find("transform") != model.end())
         {
@@ -151,11 +189,17 @@ void Scene::loadScene(const std::string &filename)
         {
             load_model.setModelMatrix(mat4(1.f));
         }
-        this->models.emplace_back(std::move(load_model));
     }
     if(j.find("environment") != j.end()){
-        auto environment_path = j.at("environment");
-        loadEnvMap(environment_path);
+        std::string environment_path = j.at("environment");
+        // IBL precompute depends on the decoded environment map so they stay in one job
+        spawn([this, environment_path, progress] { loadEnvMap(environment_path, progress); });
+    }
+    group.wait();
+
+    for (auto &load_model : load_models)
+    {
+        this->models.emplace_back(std::move(load_model));
     }
     int light_count = j.at("light_count");
     for (int i = 0; i < light_count; i++)
@@ -184,81 +228,14 @@ Camera *Scene::getCamera()
     return &camera;
 }
 
-void CreateCube(Mesh& mesh){
-    using Vertex = Triangle::Vertex;
-    static Vertex cube[8] = {
-        {{},{-1.f,-1.f,-1.f},{},{}},
-        {{},{1.f,-1.f,-1.f},{},{}},
-        {{},{1.f,1.f,-1.f},{},{}},
-        {{},{-1.f,1.f,-1.f},{},{}},
-        {{},{-1.f,-1.f,1.f},{},{}},
-        {{},{1.f,-1.f,1.f},{},{}},
-        {{},{1.f,1.f,1.f},{},{}},
-        {{},{-1.f,1.f,1.f},{},{}}
-    };
-    std::vector<Triangle> cube_triangles;
-    //total 12 triangles
-    cube_triangles.emplace_back(Triangle{cube[0],cube[1],cube[2]});
-    cube_triangles.emplace_back(Triangle{cube[0],cube[2],cube[3]});
-    cube_triangles.emplace_back(Triangle{cube[1],cube[6],cube[2]});
-    cube_triangles.emplace_back(Triangle{cube[1],cube[5],cube[6]});
-    cube_triangles.emplace_back(Triangle{cube[2],cube[6],cube[3]});
-    cube_triangles.emplace_back(Triangle{cube[3],cube[6],cube[7]});
-    cube_triangles.emplace_back(Triangle{cube[0],cube[3],cube[7]});
-    cube_triangles.emplace_back(Triangle{cube[0],cube[7],cube[4]});
-    cube_triangles.emplace_back(Triangle{cube[0],cube[4],cube[5]});
-    cube_triangles.emplace_back(Triangle{cube[0],cube[5],cube[1]});
-    cube_triangles.emplace_back(Triangle{cube[4],cube[6],cube[5]});
-    cube_triangles.emplace_back(Triangle{cube[4],cube[7],cube[6]});
-    mesh.triangles = std::move(cube_triangles);
-}
-
-void CreateSphere(Mesh& mesh){
-    static constexpr uint32_t U_SEGMENTS = 64;
-    static constexpr uint32_t V_SEGMENTS = 64;
-
-    using Vertex = Triangle::Vertex;
-    std::vector<Vertex> vertices;
-    for(int v = 0; v <= V_SEGMENTS; ++v){
-        float theta = (v - 1.f) / V_SEGMENTS * PI;
-        for(int u = 0; u <= U_SEGMENTS; ++u){
-            float phi = (u - 1.f) / U_SEGMENTS * PI * 2;
-            float x = std::cos(phi) * std::sin(theta);
-            float y = std::cos(theta);
-            float z = std::sin(phi) * std::sin(theta);
-            Vertex v;
-            v.pos = {x,y,z};
-            vertices.emplace_back(v);
-        }
-    }
-    std::vector<Triangle> triangles;
-    for(int y = 0; y < V_SEGMENTS; ++y){
-        for(int x = 0; x < U_SEGMENTS; ++x){
-            triangles.emplace_back(Triangle{
-                    vertices[x + y * (U_SEGMENTS + 1)],
-                    vertices[x + (y + 1) * (U_SEGMENTS + 1)],
-                    vertices[x + 1 + y * (U_SEGMENTS + 1)]
-                });
-            triangles.emplace_back(Triangle{
-               vertices[x + 1 + y * (U_SEGMENTS + 1)],
-                vertices[x + (y + 1) * (U_SEGMENTS + 1)],
-                vertices[x + 1 + (y + 1) * (U_SEGMENTS + 1)]
-            });
-        }
-    }
-    mesh.triangles = std::move(triangles);
-}
-
-void Scene::loadEnvMap(const std::string& name){
+void Scene::loadEnvMap(const std::string& name, LoadProgress *progress){
     skybox.reset();
     skybox = newBox<Model>();
     skybox->loadEnvironmentMap(name);
-    skybox->mesh = newBox<Mesh>();
-
-#ifdef USE_CUBE_SKY_BOX
-    CreateCube(*skybox->mesh);
-#else
-    CreateSphere(*skybox->mesh);
-#endif
+    Timer ibl_timer;
+    ibl_timer.start();
     createIBLResource(skybox->ibl,*skybox->env_mipmap);
+    ibl_timer.stop();
+    if(progress)
+        progress->ibl_ms = ibl_timer.duration().ms().count();
 }
@@ -1,16 +1,34 @@
 #pragma once
 
+#include <atomic>
+
 #include "camera.hpp"
 #include "model.hpp"
 
+// finished and total count of load jobs, updated by loading threads
+struct LoadProgress
+{
+    std::atomic<int> done{0};
+    std::atomic<int> total{0};
+    // written by the environment map job only, read after the load returns
+    double ibl_ms = 0.0;
+
+    float ratio() const
+    {
+        int t = total.load();
+        return t == 0 ? 0.f : static_cast<float>(done.load()) / static_cast<float>(t);
+    }
+};
+
 class Scene
 {
   public:
     Scene();
 
-    void loadScene(const std::string &);
+    // meshes, textures and environment map are loaded in parallel
+    void loadScene(const std::string &, LoadProgress *progress = nullptr);
 
-    void loadEnvMap(const std::string&);
+    void loadEnvMap(const std::string&, LoadProgress *progress = nullptr);
 
     void addModel(Model model);
 
@@ -39,6 +57,14 @@ class Scene
 
     void clearScene();
 
+    void clearSkyBox();
+
+    // take models and lights of loaded scene, and sky box too if it has one, camera is kept
+    void replaceWith(Scene &&loaded);
+
+    // take sky box of loaded scene
+    void replaceSkyBox(Scene &&loaded);
+
   private:
     std::vector<Model> models;
 
@@ -0,0 +1,114 @@
+#include "scene_loader.hpp"
+#include "logger.hpp"
+#include "util.hpp"
+
+SceneLoader::SceneLoader()
+{
+    load_progress = newBox<LoadProgress>();
+    worker = std::thread([this] { workerLoop(); });
+}
+
+SceneLoader::~SceneLoader()
+{
+    {
+        std::lock_guard<std::mutex> lk(mut);
+        stop = true;
+    }
+    cond.notify_all();
+    worker.join();
+}
+
+void SceneLoader::requestScene(const std::string &scene_file)
+{
+    {
+        std::lock_guard<std::mutex> lk(mut);
+        pending_scene = scene_file;
+    }
+    cond.notify_one();
+}
+
+void SceneLoader::requestEnvMap(const std::string &hdr_file)
+{
+    {
+        std::lock_guard<std::mutex> lk(mut);
+        pending_env_map = hdr_file;
+    }
+    cond.notify_one();
+}
+
+bool SceneLoader::busy() const
+{
+    std::lock_guard<std::mutex> lk(mut);
+    return loading || pending_scene || pending_env_map;
+}
+
+float SceneLoader::progress() const
+{
+    std::lock_guard<std::mutex> lk(mut);
+    return loading ? load_progress->ratio() : 0.f;
+}
+
+bool SceneLoader::apply(Scene &scene)
+{
+    Box<Scene> loaded_scene;
+    Box<Scene> loaded_env_map;
+    {
+        std::lock_guard<std::mutex> lk(mut);
+        loaded_scene = std::move(finished_scene);
+        loaded_env_map = std::move(finished_env_map);
+    }
+    if (loaded_scene)
+        scene.replaceWith(std::move(*loaded_scene));
+    if (loaded_env_map)
+        scene.replaceSkyBox(std::move(*loaded_env_map));
+    return loaded_scene || loaded_env_map;
+}
+
+void SceneLoader::workerLoop()
+{
+    while (true)
+    {
+        std::string path;
+        bool is_env_map;
+        {
+            std::unique_lock<std::mutex> lk(mut);
+            cond.wait(lk, [this] { return stop || pending_scene || pending_env_map; });
+            if (stop)
+                return;
+            is_env_map = !pending_scene;
+            auto &pending = is_env_map ? pending_env_map : pending_scene;
+            path = std::move(*pending);
+            pending.reset();
+            loading = true;
+            load_progress = newBox<LoadProgress>();
+        }
+
+        LOG_INFO("start loading: {}", path);
+        Timer timer;
+        timer.start();
+        auto scene = newBox<Scene>();
+        try
+        {
+            if (is_env_map)
+                scene->loadEnvMap(path);
+            else
+                scene->loadScene(path, load_progress.get());
+        }
+        catch (const std::exception &err)
+        {
+            LOG_ERROR("load {} failed: {}", path, err.what());
+            scene.reset();
+        }
+        timer.stop();
+
+        std::lock_guard<std::mutex> lk(mut);
+        loading = false;
+        // a newer request of the same kind supersedes this result
+        const bool superseded = is_env_map ? pending_env_map.has_value() : pending_scene.has_value();
+        if (scene && !superseded && !stop)
+        {
+            LOG_INFO("finish loading {} in {}", path, timer.duration_str());
+            (is_env_map ? finished_env_map : finished_scene) = std::move(scene);
+        }
+    }
+}
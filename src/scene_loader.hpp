@@ -0,0 +1,58 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include "scene.hpp"
+
+/**
+ * @brief load scene and environment map files on a background thread into a separate scene,
+ * which is swapped into the rendered scene by apply() between frames, so rendering goes on
+ * with the previous scene while loading. Scene files and environment maps are queued separately,
+ * if a new request of the same kind arrives while loading, result of the running one is dropped
+ * and only the latest one is applied.
+ */
+class SceneLoader
+{
+  public:
+    SceneLoader();
+
+    // wait for running load to finish
+    ~SceneLoader();
+
+    SceneLoader(const SceneLoader &) = delete;
+
+    SceneLoader &operator=(const SceneLoader &) = delete;
+
+    void requestScene(const std::string &scene_file);
+
+    void requestEnvMap(const std::string &hdr_file);
+
+    bool busy() const;
+
+    // progress of running load in [0, 1]
+    float progress() const;
+
+    // call from render thread, move finished result into scene and return true if there is one
+    bool apply(Scene &scene);
+
+  private:
+    void workerLoop();
+
+  private:
+    std::thread worker;
+    mutable std::mutex mut;
+    std::condition_variable cond;
+    std::optional<std::string> pending_scene;
+    std::optional<std::string> pending_env_map;
+    bool loading = false;
+    bool stop = false;
+    Box<Scene> finished_scene;
+    // scene only holding a sky box
+    Box<Scene> finished_env_map;
+    // reset by worker only when it starts a new request
+    Box<LoadProgress> load_progress;
+};
@@ -3,23 +3,75 @@
 #include <omp.h>
 
 #include "mesh.hpp"
+#include "simd.hpp"
 #include "texture.hpp"
+#include "vertex_transform.hpp"
 
 class PBRShader;
-class SkyShader;
+
+// fragments shaded by one call, attributes are stored per component so lane loops vectorize
+// lanes outside mask hold copies of an active one so shaders may compute them freely and only skip the store
+struct FragmentPacket
+{
+    static constexpr int Size = 8;
+
+    alignas(32) float pos_x[Size];
+    alignas(32) float pos_y[Size];
+    alignas(32) float pos_z[Size];
+    alignas(32) float normal_x[Size];
+    alignas(32) float normal_y[Size];
+    alignas(32) float normal_z[Size];
+    alignas(32) float u[Size];
+    alignas(32) float v[Size];
+    // screen space derivatives of texture coordinate shared by the 2x2 quad of a lane
+    alignas(32) float du_dx[Size];
+    alignas(32) float dv_dx[Size];
+    alignas(32) float du_dy[Size];
+    alignas(32) float dv_dy[Size];
+    uint32_t mask = 0;
+
+    color4b color[Size];
+
+    float3 position(int i) const
+    {
+        return {pos_x[i], pos_y[i], pos_z[i]};
+    }
+
+    float3 normal(int i) const
+    {
+        return {normal_x[i], normal_y[i], normal_z[i]};
+    }
+
+    float2 texCoord(int i) const
+    {
+        return {u[i], v[i]};
+    }
+
+    vfloat3 position() const
+    {
+        return vfloat3::load(pos_x, pos_y, pos_z);
+    }
+
+    vfloat3 normal() const
+    {
+        return vfloat3::load(normal_x, normal_y, normal_z);
+    }
+};
+
+static_assert(FragmentPacket::Size == vfloat::Size, "a packet is shaded as one vfloat per attribute");
 
 class IShader
 {
   public:
     virtual ~IShader() = default;
 
-    virtual Triangle vertexShader(const Triangle &inTriangle) const  = 0;
+    // transform mesh vertices [beg,end) into out, one call covers a whole batch
+    virtual void vertexShader(const Mesh &mesh, int beg, int end, Triangle::Vertex *out) const = 0;
 
-    virtual color4b fragmentShader(const float3 &inPos, const float3 &inNormal, const float2 &inTexCoord) const = 0;
+    // shade every lane of packet into packet.color
+    virtual void fragmentShader(FragmentPacket &packet) const = 0;
 
     virtual const PBRShader* asPBRShader() const {return nullptr;}
-
-    virtual const SkyShader* asSkyShader() const {return nullptr;}
 };
 
 inline color4b float3_to_color4b(const float3 &v)
@@ -29,32 +81,41 @@ inline color4b float3_to_color4b(const float3 &v)
                    std::clamp(v.z,0.f,1.f) * 255, 255};
 }
 
-class SkyShader: public IShader{
-  public:
-    mat4 model, view, projection, MVPMatrix;
+inline void store_packet_colors(FragmentPacket &packet, const float3 *colors)
+{
+    for (int i = 0; i < FragmentPacket::Size; i++)
+    {
+        packet.color[i] = float3_to_color4b(colors[i]);
+    }
+}
+
+inline void store_packet_colors(FragmentPacket &packet, const vfloat3 &colors)
+{
+    float r[FragmentPacket::Size], g[FragmentPacket::Size], b[FragmentPacket::Size];
+    clamp(colors, 0.f, 1.f).store(r, g, b);
+    for (int i = 0; i < FragmentPacket::Size; i++)
+    {
+        packet.color[i] = color4b{r[i] * 255, g[i] * 255, b[i] * 255, 255};
+    }
+}
 
-    const MipMap2D<float3>* envMap;
+inline vfloat pow5(const vfloat &x)
+{
+    vfloat x2 = x * x;
+    return x2 * x2 * x;
+}
 
-    const SkyShader* asSkyShader() const override{ return this; }
+// state of the screen space sky pass, see SoftRenderer::renderBackground
+class SkyShader{
+  public:
+    mat4 view, projection;
 
-    Triangle vertexShader(const Triangle &inTriangle) const override{
-        Triangle outTriangle;
-        mat4 rotView = mat4(mat3(view));
-        for (int i = 0; i < 3; i++)
-        {
-            auto clipPos = projection * rotView * model * float4(inTriangle.vertices[i].pos, 1.f);
-            outTriangle.vertices[i].gl_Position = {clipPos.x,clipPos.y,clipPos.w,clipPos.w};
-            outTriangle.vertices[i].pos = model * float4(inTriangle.vertices[i].pos, 1.f);
-            outTriangle.vertices[i].normal = model * float4(inTriangle.vertices[i].normal, 0.f);
-            outTriangle.vertices[i].tex_coord = inTriangle.vertices[i].tex_coord;
-        }
-        return outTriangle;
-    }
+    // environment in octahedral layout
+    const PackedTexture<RGB9E5>* skyMap;
 
-    color4b fragmentShader(const float3 &inPos, const float3 &inNormal, const float2 &inTexCoord) const override{
-        float2 uv = sampleSphericalMap(normalize(inPos));
-        auto env_color = LinearSampler::sample2D(envMap->get_level(0),uv.x,uv.y);
-        return float3_to_color4b(env_color);
+    // dir is in world space and need not be normalized
+    float3 sampleSky(const float3 &dir) const{
+        return OctahedralSampler::sample(*skyMap,dir);
     }
 };
 
@@ -63,13 +124,13 @@ class PBRShader : public IShader
   public:
     mat4 model, view, projection, MVPMatrix;
 
-    const Texture<float3> *albedoMap;
-    const Texture<float3> *normalMap;
-    const Texture<float> *aoMap;
-    const Texture<float> *roughnessMap;
-    const Texture<float> *metallicMap;
+    const TextureRGBA8 *albedoMap;
+    const TextureRG8 *normalMap;
+    const TextureR8 *aoMap;
+    const TextureR8 *roughnessMap;
+    const TextureR8 *metallicMap;
 
-    const MipMap2D<float3>* envMap;
+    const TextureRGB9E5* envMap;
 
     float3 viewPos;
 
@@ -95,14 +156,14 @@ class PBRShader : public IShader
         {-0.00327, -0.07276,  1.07602}
     };
 
-    static float3 RRTAndODTFit(float3 v)
+    static vfloat3 RRTAndODTFit(const vfloat3 &v)
     {
-        float3 a = v * (v + 0.0245786f) - 0.000090537f;
-        float3 b = v * (0.983729f * v + 0.4329510f) + 0.238081f;
+        vfloat3 a = v * (v + 0.0245786f) - 0.000090537f;
+        vfloat3 b = v * (0.983729f * v + 0.4329510f) + 0.238081f;
         return a / b;
     }
 
-    static float3 ACESFitted(float3 color)
+    static vfloat3 ACESFitted(vfloat3 color)
     {
         color = ACESInputMat * color;
 
@@ -112,156 +173,214 @@ class PBRShader : public IShader
         color = ACESOutputMat * color;
 
         // Clamp to [0, 1]
-        color = clamp(color,float3(0),float3(1));
+        color = clamp(color, 0.f, 1.f);
 
         return color;
     }
 
     const PBRShader* asPBRShader() const { return this; }
 
-    Triangle vertexShader(const Triangle &inTriangle) const override
+    void vertexShader(const Mesh &mesh, int beg, int end, Triangle::Vertex *out) const override
     {
-        Triangle outTriangle;
-        for (int i = 0; i < 3; i++)
-        {
-            outTriangle.vertices[i].gl_Position = MVPMatrix * float4(inTriangle.vertices[i].pos, 1.f);
-            outTriangle.vertices[i].pos = model * float4(inTriangle.vertices[i].pos, 1.f);
-            outTriangle.vertices[i].normal = model * float4(inTriangle.vertices[i].normal, 0.f);
-            outTriangle.vertices[i].tex_coord = inTriangle.vertices[i].tex_coord;
-        }
-        return outTriangle;
+        TransformVertices(mesh, beg, end, MVPMatrix, model, out);
     }
 
-    static float DistributionGGX(const float3 &N, const float3 &H, float roughness)
+    static vfloat DistributionGGX(const vfloat3 &N, const vfloat3 &H, const vfloat &roughness)
     {
-        float a = roughness * roughness;
-        float a2 = a * a;
-        float NdotH = std::max(dot(N, H), 0.f);
-        float NdotH2 = NdotH * NdotH;
+        vfloat a = roughness * roughness;
+        vfloat a2 = a * a;
+        vfloat NdotH = max(dot(N, H), 0.f);
+        vfloat NdotH2 = NdotH * NdotH;
 
-        float nom = a2;
-        float denom = (NdotH2 * (a2 - 1.f) + 1.f);
+        vfloat nom = a2;
+        vfloat denom = (NdotH2 * (a2 - 1.f) + 1.f);
         denom = PI * denom * denom;
         return nom / denom;
     }
 
-    static float GeometrySchlickGGX(float NdotV, float roughtness)
+    static vfloat GeometrySchlickGGX(const vfloat &NdotV, const vfloat &roughtness)
     {
-        float r = roughtness + 1.f;
-        float k = r * r * 0.125f;
-        float nom = NdotV;
-        float denom = NdotV * (1.f - k) + k;
+        vfloat r = roughtness + 1.f;
+        vfloat k = r * r * 0.125f;
+        vfloat nom = NdotV;
+        vfloat denom = NdotV * (1.f - k) + k;
         return nom / denom;
     }
 
-    static float GeometrySmith(float NdotV, float NdotL, float roughness)
+    static vfloat GeometrySmith(const vfloat &NdotV, const vfloat &NdotL, const vfloat &roughness)
     {
         return GeometrySchlickGGX(NdotV, roughness) * GeometrySchlickGGX(NdotL, roughness);
     }
 
-    static float3 fresnelSchlick(float cosTheta, const float3& F0)
+    static vfloat3 fresnelSchlick(const vfloat &cosTheta, const vfloat3 &F0)
     {
-        return F0 + (1.f - F0) * std::pow(std::max(1.f - cosTheta, 0.f), 5.f);
+        return F0 + (1.f - F0) * pow5(max(1.f - cosTheta, 0.f));
     }
 
-    color4b fragmentShader(const float3 &inPos, const float3 &inNormal, const float2 &inTexCoord) const override
+    // material of every lane, textures are fetched lane by lane since they are gathers
+    struct MaterialPacket
+    {
+        vfloat3 albedo;
+        vfloat metallic;
+        vfloat roughness;
+        vfloat ao;
+    };
+
+    MaterialPacket sampleMaterial(const FragmentPacket &packet) const
     {
-        float3 albedo = LinearSampler::sample2D(*albedoMap, inTexCoord.x, inTexCoord.y);
-        float metallic = LinearSampler::sample2D(*metallicMap, inTexCoord.x, inTexCoord.y);
-        float roughness = LinearSampler::sample2D(*roughnessMap, inTexCoord.x, inTexCoord.y);
-        float ao = LinearSampler::sample2D(*aoMap, inTexCoord.x, inTexCoord.y);
-        float3 N = normalize(inNormal);
-        float3 V = normalize(viewPos - inPos);
-        float NdotV = std::max(dot(N, V), 0.f);
-        float3 F0{0.04f, 0.04f, 0.04f};
-        F0 = F0 * (1.f - metallic) + metallic * albedo;
-
-        float3 Lo{0.f, 0.f, 0.f};
-#ifdef USE_OMP
-#pragma omp simd
-#endif
+        float r[FragmentPacket::Size], g[FragmentPacket::Size], b[FragmentPacket::Size];
+        float metallic[FragmentPacket::Size], roughness[FragmentPacket::Size], ao[FragmentPacket::Size];
+        for (int i = 0; i < FragmentPacket::Size; i++)
+        {
+            // maps of one material mostly share a size so the level of albedo is reused for them
+            const float albedo_level = LinearSampler::mipLevel(*albedoMap, packet.du_dx[i], packet.dv_dx[i],
+                                                               packet.du_dy[i], packet.dv_dy[i]);
+            auto level = [&](const TextureR8 &map) {
+                if (map.width() == albedoMap->width() && map.height() == albedoMap->height())
+                    return albedo_level;
+                return LinearSampler::mipLevel(map, packet.du_dx[i], packet.dv_dx[i], packet.du_dy[i], packet.dv_dy[i]);
+            };
+            float3 albedo = LinearSampler::sample2D(*albedoMap, packet.u[i], packet.v[i], albedo_level);
+            r[i]          = albedo.r;
+            g[i]          = albedo.g;
+            b[i]          = albedo.b;
+            metallic[i]   = LinearSampler::sample2D(*metallicMap, packet.u[i], packet.v[i], level(*metallicMap));
+            roughness[i]  = LinearSampler::sample2D(*roughnessMap, packet.u[i], packet.v[i], level(*roughnessMap));
+            ao[i]         = LinearSampler::sample2D(*aoMap, packet.u[i], packet.v[i], level(*aoMap));
+        }
+        return {vfloat3::load(r, g, b), vfloat::load(metallic), vfloat::load(roughness), vfloat::load(ao)};
+    }
+
+    void fragmentShader(FragmentPacket &packet) const override
+    {
+        const auto material = sampleMaterial(packet);
+        const vfloat3 &albedo = material.albedo;
+        const vfloat &metallic = material.metallic;
+        const vfloat &roughness = material.roughness;
+
+        vfloat3 pos = packet.position();
+        vfloat3 N = normalize(packet.normal());
+        vfloat3 V = normalize(vfloat3(viewPos) - pos);
+        vfloat NdotV = max(dot(N, V), 0.f);
+        vfloat3 F0 = 0.04f * (1.f - metallic) + metallic * albedo;
+
+        vfloat3 Lo(0.f);
         for (int i = 0; i < lightNum; i++)
         {
-            float3 L = normalize(lightPos[i] - inPos);
-            float3 H = normalize(V + L);
-            float d2 = dot(lightPos[i] - inPos, lightPos[i] - inPos);
-            float attenuation = 1.f / d2;
-            float3 radiance = lightRadiance[i] * attenuation;
-            float NdotL = std::max(dot(N, L), 0.f);
-            float NDF = DistributionGGX(N, H, roughness);
-            float G = GeometrySmith(NdotV, NdotL, roughness);
-            float3 F = fresnelSchlick(std::max(dot(H, V), 0.f), F0);
-
-            float3 numerator = NDF * G * F;
-            float denominator = 4 * NdotV * NdotL + 0.001f;
-            float3 specular = numerator / denominator;
-
-            float3 kS = F;
-            float3 kD = float3(1.f) - kS;
-            kD *= 1.f - metallic;
+            vfloat3 to_light = vfloat3(lightPos[i]) - pos;
+            vfloat3 L = normalize(to_light);
+            vfloat3 H = normalize(V + L);
+            vfloat d2 = dot(to_light, to_light);
+            vfloat attenuation = 1.f / d2;
+            vfloat3 radiance = vfloat3(lightRadiance[i]) * attenuation;
+            vfloat NdotL = max(dot(N, L), 0.f);
+            vfloat NDF = DistributionGGX(N, H, roughness);
+            vfloat G = GeometrySmith(NdotV, NdotL, roughness);
+            vfloat3 F = fresnelSchlick(max(dot(H, V), 0.f), F0);
+
+            vfloat3 numerator = NDF * G * F;
+            vfloat denominator = 4.f * NdotV * NdotL + 0.001f;
+            vfloat3 specular = numerator / denominator;
+
+            vfloat3 kS = F;
+            vfloat3 kD = 1.f - kS;
+            kD = kD * (1.f - metallic);
 
             Lo += (kD * albedo / PI + specular) * radiance * NdotL;
         }
 
-        float3 ambient = float3(0.03f) * albedo * ao;
+        vfloat3 ambient = 0.03f * albedo * material.ao;
 
-        float3 color = ambient + Lo;
+        vfloat3 color = ambient + Lo;
 
-        color = ACESFitted(color);
-
-        return float3_to_color4b(color);
+        store_packet_colors(packet, ACESFitted(color));
     }
 };
 
 class IBLShader : public PBRShader{
   public:
-    const Texture<float3>* irradiance_map;
-    const MipMap2D<float3>* prefilter_map;
-    const Texture<float2>* brdf_lut;
-
-    static float3 fresnelSchlickRoughness(float cosTheta, vec3 F0, float roughness){
-        return F0 + (max(float3(1.0f - roughness), F0) - F0) * std::pow(std::max(1.0f - cosTheta, 0.0f), 5.0f);
+    const PackedTexture<RGB9E5>* irradiance_map;
+    // irradiance_map is not read if it is set
+    const std::array<float3, 9>* irradiance_sh = nullptr;
+    const TextureRGB9E5* prefilter_map;
+    // analytic fit of it is used if it is not set
+    const TextureRG16* brdf_lut = nullptr;
+
+    // sum of coefficients times basis at unit direction N, negative ringing of bright lights is clamped
+    static vfloat3 irradianceSH(const std::array<float3, 9> &sh, const vfloat3 &N){
+        vfloat basis[9];
+        SHBasis9(N.x,N.y,N.z,basis);
+        vfloat3 irradiance = vfloat3(sh[0]) * basis[0];
+        for(int i = 1; i < 9; i++){
+            irradiance += vfloat3(sh[i]) * basis[i];
+        }
+        return max(irradiance,vfloat3(vfloat(0.f)));
     }
 
-    color4b fragmentShader(const float3 &inPos, const float3 &inNormal, const float2 &inTexCoord) const override{
-        float3 albedo   = LinearSampler::sample2D(*albedoMap, inTexCoord.x, inTexCoord.y);
-        float metallic  = LinearSampler::sample2D(*metallicMap, inTexCoord.x, inTexCoord.y);
-        float roughness = LinearSampler::sample2D(*roughnessMap, inTexCoord.x, inTexCoord.y);
-        float ao        = LinearSampler::sample2D(*aoMap, inTexCoord.x, inTexCoord.y);
-
-        float3 N = normalize(inNormal);
-        float3 V = normalize(viewPos - inPos);
-        float3 R = normalize(dot(N,V)*N-V);
-
-        float3 F0 = float3(0.04f);
-        F0 = mix(F0,albedo,metallic);
-
-        float3 Lo = float3(0.f);
-
-        float NdotV = std::max(dot(N,V),0.f);
-
-        float3 F = fresnelSchlickRoughness(NdotV,F0,roughness);
-
-        float3 kS = F;
-        float3 kD = 1.f - kS;
-        kD *= 1.f - metallic;
-        float2 uv = sampleSphericalMap(N);
-        float3 irradiance = LinearSampler::sample2D(*irradiance_map,uv.x,uv.y);
-        float3 diffuse = irradiance * albedo;
+    // Karis' fit of split sum scale and bias of F0 for mobile, within a few percent of brdf lut
+    static float2 envBRDFApprox(float NdotV, float roughness){
+        const float4 c0 = {-1.f, -0.0275f, -0.572f, 0.022f};
+        const float4 c1 = {1.f, 0.0425f, 1.04f, -0.04f};
+        const float4 r = roughness * c0 + c1;
+        const float a004 = std::min(r.x * r.x, std::exp2(-9.28f * NdotV)) * r.x + r.y;
+        return float2(-1.04f, 1.04f) * a004 + float2(r.z, r.w);
+    }
 
-        uv = sampleSphericalMap(R);
-        float3 prefilter_color = LinearSampler::sample2D(*prefilter_map,uv.x,uv.y,roughness * (prefilter_map->levels() - 1));
+    static vfloat3 fresnelSchlickRoughness(const vfloat &cosTheta, const vfloat3 &F0, const vfloat &roughness){
+        return F0 + (max(vfloat3(1.0f - roughness), F0) - F0) * pow5(max(1.0f - cosTheta, 0.0f));
+    }
 
-        float2 brdf = LinearSampler::sample2D(*brdf_lut,NdotV,roughness);
+    void fragmentShader(FragmentPacket &packet) const override{
+        constexpr int Size = FragmentPacket::Size;
+        const auto material = sampleMaterial(packet);
+        const vfloat3 &albedo = material.albedo;
+        const vfloat &metallic = material.metallic;
+        const vfloat &roughness = material.roughness;
+
+        vfloat3 N = normalize(packet.normal());
+        vfloat3 V = normalize(vfloat3(viewPos) - packet.position());
+        vfloat3 R = normalize(dot(N,V)*N-V);
+
+        vfloat3 F0 = 0.04f * (1.f - metallic) + metallic * albedo;
+
+        vfloat NdotV = max(dot(N,V),0.f);
+
+        // environment lookups are gathers too
+        float n[3][Size], r[3][Size], n_dot_v[Size], rough[Size];
+        N.store(n[0],n[1],n[2]);
+        R.store(r[0],r[1],r[2]);
+        NdotV.store(n_dot_v);
+        roughness.store(rough);
+        const float max_level = static_cast<float>(prefilter_map->levels() - 1);
+        float irradiance[3][Size], prefilter_color[3][Size], brdf[2][Size];
+        for(int i = 0; i < Size; i++){
+            float3 irradiance_i = irradiance_sh ? float3(0.f)
+                                                : OctahedralSampler::sample(*irradiance_map,{n[0][i],n[1][i],n[2][i]});
+            float3 prefilter_i = OctahedralSampler::sample(*prefilter_map,{r[0][i],r[1][i],r[2][i]},
+                                                           rough[i] * max_level);
+            float2 brdf_i = brdf_lut ? LinearSampler::sample2D(*brdf_lut,n_dot_v[i],rough[i])
+                                     : envBRDFApprox(n_dot_v[i],rough[i]);
+            for(int c = 0; c < 3; c++){
+                irradiance[c][i] = irradiance_i[c];
+                prefilter_color[c][i] = prefilter_i[c];
+            }
+            brdf[0][i] = brdf_i.x;
+            brdf[1][i] = brdf_i.y;
+        }
 
-        float3 specular = prefilter_color * (F * brdf.x + brdf.y);
+        vfloat3 F = fresnelSchlickRoughness(NdotV,F0,roughness);
 
-        float3 ambient = (kD * diffuse + specular) * ao;
+        vfloat3 kS = F;
+        vfloat3 kD = 1.f - kS;
+        kD = kD * (1.f - metallic);
+        vfloat3 diffuse = (irradiance_sh ? irradianceSH(*irradiance_sh,N)
+                                         : vfloat3::load(irradiance[0],irradiance[1],irradiance[2])) * albedo;
 
-        float3 color = ambient + Lo;
+        vfloat3 specular = vfloat3::load(prefilter_color[0],prefilter_color[1],prefilter_color[2]) *
+                           (F * vfloat::load(brdf[0]) + vfloat::load(brdf[1]));
 
-        color = ACESFitted(color);
+        vfloat3 ambient = (kD * diffuse + specular) * material.ao;
 
-        return float3_to_color4b(color);
+        store_packet_colors(packet, ACESFitted(ambient));
     }
 };
\ No newline at end of file
@@ -0,0 +1,279 @@
+#pragma once
+
+#include <cmath>
+
+#include "common.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#define SIMD_USE_SSE
+#include <emmintrin.h>
+#endif
+
+// one float of every lane of a fragment packet, two sse registers or a plain array without sse
+struct vfloat
+{
+    static constexpr int Size = 8;
+
+#ifdef SIMD_USE_SSE
+    __m128 lo, hi;
+
+    vfloat() = default;
+
+    vfloat(float s) : lo(_mm_set1_ps(s)), hi(_mm_set1_ps(s))
+    {
+    }
+
+    vfloat(__m128 lo, __m128 hi) : lo(lo), hi(hi)
+    {
+    }
+
+    static vfloat load(const float *p)
+    {
+        return {_mm_loadu_ps(p), _mm_loadu_ps(p + 4)};
+    }
+
+    void store(float *p) const
+    {
+        _mm_storeu_ps(p, lo);
+        _mm_storeu_ps(p + 4, hi);
+    }
+
+    friend vfloat operator+(const vfloat &a, const vfloat &b)
+    {
+        return {_mm_add_ps(a.lo, b.lo), _mm_add_ps(a.hi, b.hi)};
+    }
+
+    friend vfloat operator-(const vfloat &a, const vfloat &b)
+    {
+        return {_mm_sub_ps(a.lo, b.lo), _mm_sub_ps(a.hi, b.hi)};
+    }
+
+    friend vfloat operator*(const vfloat &a, const vfloat &b)
+    {
+        return {_mm_mul_ps(a.lo, b.lo), _mm_mul_ps(a.hi, b.hi)};
+    }
+
+    friend vfloat operator/(const vfloat &a, const vfloat &b)
+    {
+        return {_mm_div_ps(a.lo, b.lo), _mm_div_ps(a.hi, b.hi)};
+    }
+
+    friend vfloat min(const vfloat &a, const vfloat &b)
+    {
+        return {_mm_min_ps(a.lo, b.lo), _mm_min_ps(a.hi, b.hi)};
+    }
+
+    friend vfloat max(const vfloat &a, const vfloat &b)
+    {
+        return {_mm_max_ps(a.lo, b.lo), _mm_max_ps(a.hi, b.hi)};
+    }
+
+    friend vfloat sqrt(const vfloat &a)
+    {
+        return {_mm_sqrt_ps(a.lo), _mm_sqrt_ps(a.hi)};
+    }
+#else
+    float v[Size];
+
+    vfloat() = default;
+
+    vfloat(float s)
+    {
+        for (int i = 0; i < Size; i++)
+            v[i] = s;
+    }
+
+    static vfloat load(const float *p)
+    {
+        vfloat r;
+        for (int i = 0; i < Size; i++)
+            r.v[i] = p[i];
+        return r;
+    }
+
+    void store(float *p) const
+    {
+        for (int i = 0; i < Size; i++)
+            p[i] = v[i];
+    }
+
+#define VFLOAT_LANE_OP(expr)                                                                                           \
+    vfloat r;                                                                                                          \
+    for (int i = 0; i < Size; i++)                                                                                     \
+        r.v[i] = (expr);                                                                                               \
+    return r;
+
+    friend vfloat operator+(const vfloat &a, const vfloat &b)
+    {
+        VFLOAT_LANE_OP(a.v[i] + b.v[i])
+    }
+
+    friend vfloat operator-(const vfloat &a, const vfloat &b)
+    {
+        VFLOAT_LANE_OP(a.v[i] - b.v[i])
+    }
+
+    friend vfloat operator*(const vfloat &a, const vfloat &b)
+    {
+        VFLOAT_LANE_OP(a.v[i] * b.v[i])
+    }
+
+    friend vfloat operator/(const vfloat &a, const vfloat &b)
+    {
+        VFLOAT_LANE_OP(a.v[i] / b.v[i])
+    }
+
+    friend vfloat min(const vfloat &a, const vfloat &b)
+    {
+        VFLOAT_LANE_OP(b.v[i] < a.v[i] ? b.v[i] : a.v[i])
+    }
+
+    friend vfloat max(const vfloat &a, const vfloat &b)
+    {
+        VFLOAT_LANE_OP(a.v[i] < b.v[i] ? b.v[i] : a.v[i])
+    }
+
+    friend vfloat sqrt(const vfloat &a)
+    {
+        VFLOAT_LANE_OP(std::sqrt(a.v[i]))
+    }
+
+#undef VFLOAT_LANE_OP
+#endif
+
+    vfloat &operator+=(const vfloat &b)
+    {
+        return *this = *this + b;
+    }
+
+    vfloat &operator*=(const vfloat &b)
+    {
+        return *this = *this * b;
+    }
+
+    friend vfloat clamp(const vfloat &a, const vfloat &lo, const vfloat &hi)
+    {
+        return min(max(a, lo), hi);
+    }
+};
+
+// float3 of every lane stored per component
+struct vfloat3
+{
+    vfloat x, y, z;
+
+    vfloat3() = default;
+
+    vfloat3(const vfloat &x, const vfloat &y, const vfloat &z) : x(x), y(y), z(z)
+    {
+    }
+
+    explicit vfloat3(const vfloat &s) : x(s), y(s), z(s)
+    {
+    }
+
+    explicit vfloat3(const float3 &v) : x(v.x), y(v.y), z(v.z)
+    {
+    }
+
+    static vfloat3 load(const float *x, const float *y, const float *z)
+    {
+        return {vfloat::load(x), vfloat::load(y), vfloat::load(z)};
+    }
+
+    void store(float *px, float *py, float *pz) const
+    {
+        x.store(px);
+        y.store(py);
+        z.store(pz);
+    }
+
+    friend vfloat3 operator+(const vfloat3 &a, const vfloat3 &b)
+    {
+        return {a.x + b.x, a.y + b.y, a.z + b.z};
+    }
+
+    friend vfloat3 operator-(const vfloat3 &a, const vfloat3 &b)
+    {
+        return {a.x - b.x, a.y - b.y, a.z - b.z};
+    }
+
+    friend vfloat3 operator*(const vfloat3 &a, const vfloat3 &b)
+    {
+        return {a.x * b.x, a.y * b.y, a.z * b.z};
+    }
+
+    friend vfloat3 operator/(const vfloat3 &a, const vfloat3 &b)
+    {
+        return {a.x / b.x, a.y / b.y, a.z / b.z};
+    }
+
+    friend vfloat3 operator+(const vfloat3 &a, const vfloat &s)
+    {
+        return {a.x + s, a.y + s, a.z + s};
+    }
+
+    friend vfloat3 operator+(const vfloat &s, const vfloat3 &a)
+    {
+        return a + s;
+    }
+
+    friend vfloat3 operator-(const vfloat3 &a, const vfloat &s)
+    {
+        return {a.x - s, a.y - s, a.z - s};
+    }
+
+    friend vfloat3 operator-(const vfloat &s, const vfloat3 &a)
+    {
+        return {s - a.x, s - a.y, s - a.z};
+    }
+
+    friend vfloat3 operator*(const vfloat3 &a, const vfloat &s)
+    {
+        return {a.x * s, a.y * s, a.z * s};
+    }
+
+    friend vfloat3 operator/(const vfloat3 &a, const vfloat &s)
+    {
+        return {a.x / s, a.y / s, a.z / s};
+    }
+
+    friend vfloat3 operator*(const vfloat &s, const vfloat3 &a)
+    {
+        return {a.x * s, a.y * s, a.z * s};
+    }
+
+    vfloat3 &operator+=(const vfloat3 &b)
+    {
+        return *this = *this + b;
+    }
+
+    friend vfloat dot(const vfloat3 &a, const vfloat3 &b)
+    {
+        return a.x * b.x + a.y * b.y + a.z * b.z;
+    }
+
+    friend vfloat3 normalize(const vfloat3 &a)
+    {
+        vfloat inv_length = vfloat(1.f) / sqrt(dot(a, a));
+        return a * inv_length;
+    }
+
+    friend vfloat3 max(const vfloat3 &a, const vfloat3 &b)
+    {
+        return {max(a.x, b.x), max(a.y, b.y), max(a.z, b.z)};
+    }
+
+    friend vfloat3 clamp(const vfloat3 &a, const vfloat &lo, const vfloat &hi)
+    {
+        return {clamp(a.x, lo, hi), clamp(a.y, lo, hi), clamp(a.z, lo, hi)};
+    }
+
+    // m * a of every lane
+    friend vfloat3 operator*(const mat3 &m, const vfloat3 &a)
+    {
+        return {vfloat(m[0][0]) * a.x + vfloat(m[1][0]) * a.y + vfloat(m[2][0]) * a.z,
+                vfloat(m[0][1]) * a.x + vfloat(m[1][1]) * a.y + vfloat(m[2][1]) * a.z,
+                vfloat(m[0][2]) * a.x + vfloat(m[1][2]) * a.y + vfloat(m[2][2]) * a.z};
+    }
+};
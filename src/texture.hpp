@@ -1,6 +1,10 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
 
 #include "buffer.hpp"
 #include "common.hpp"
@@ -9,10 +13,350 @@
 template <typename T>
 using Texture = Image<T>;
 
+// texel formats of material textures which keep 8 bit channels as loaded
+// encode packs Channels bytes from image loader into a texel, decode turns a texel into float in sampler
+// and average filters count texels into one of the next mip level
+struct R8
+{
+    using Texel = uint8_t;
+    static constexpr int Channels = 1;
+
+    static Texel encode(const uint8_t *p)
+    {
+        return p[0];
+    }
+
+    static float decode(Texel t)
+    {
+        return static_cast<float>(t) * (1.f / 255.f);
+    }
+
+    static Texel average(const Texel *t, int count)
+    {
+        int sum = 0;
+        for (int i = 0; i < count; i++)
+            sum += t[i];
+        return static_cast<Texel>((sum + count / 2) / count);
+    }
+};
+
+// gamma 2.2 of every 8 bit value
+inline const std::array<float, 256> SRGBToLinearTable = [] {
+    std::array<float, 256> t{};
+    for (int i = 0; i < 256; i++)
+        t[i] = std::pow(static_cast<float>(i) / 255.f, 2.2f);
+    return t;
+}();
+
+struct RGBA8_SRGB
+{
+    using Texel = color4b;
+    static constexpr int Channels = 4;
+
+    static Texel encode(const uint8_t *p)
+    {
+        return {p[0], p[1], p[2], p[3]};
+    }
+
+    static float3 decode(Texel t)
+    {
+        return {SRGBToLinearTable[t.r], SRGBToLinearTable[t.g], SRGBToLinearTable[t.b]};
+    }
+
+    // color is averaged in linear space so darker mips do not appear
+    static Texel average(const Texel *t, int count)
+    {
+        float3 sum{0.f};
+        int alpha = 0;
+        for (int i = 0; i < count; i++)
+        {
+            sum += decode(t[i]);
+            alpha += t[i].a;
+        }
+        auto to_srgb = [&](float v) {
+            return static_cast<uint8_t>(std::pow(v / static_cast<float>(count), 1.f / 2.2f) * 255.f + 0.5f);
+        };
+        return {to_srgb(sum.r), to_srgb(sum.g), to_srgb(sum.b), static_cast<uint8_t>((alpha + count / 2) / count)};
+    }
+};
+
+// unit tangent space normal with z >= 0 so only x and y are stored
+struct RG8_Normal
+{
+    using Texel = glm::vec<2, uint8_t>;
+    static constexpr int Channels = 3;
+
+    static Texel encode(const uint8_t *p)
+    {
+        return {p[0], p[1]};
+    }
+
+    static float3 decode(Texel t)
+    {
+        float x = static_cast<float>(t.x) * (2.f / 255.f) - 1.f;
+        float y = static_cast<float>(t.y) * (2.f / 255.f) - 1.f;
+        return {x, y, std::sqrt(std::max(0.f, 1.f - x * x - y * y))};
+    }
+
+    static Texel average(const Texel *t, int count)
+    {
+        float3 sum{0.f};
+        for (int i = 0; i < count; i++)
+            sum += decode(t[i]);
+        float3 n = length(sum) > 0.f ? normalize(sum) : float3{0.f, 0.f, 1.f};
+        auto to_unorm = [](float v) { return static_cast<uint8_t>(std::clamp((v + 1.f) * 127.5f + 0.5f, 0.f, 255.f)); };
+        return {to_unorm(n.x), to_unorm(n.y)};
+    }
+};
+
+// two values in [0, 1] as 16 bit unorm, textures of it are filled texel by texel instead of from image loader
+struct RG16
+{
+    using Texel = glm::vec<2, uint16_t>;
+
+    static Texel encode(const float2 &v)
+    {
+        auto to_unorm = [](float c) { return static_cast<uint16_t>(std::clamp(c, 0.f, 1.f) * 65535.f + 0.5f); };
+        return {to_unorm(v.x), to_unorm(v.y)};
+    }
+
+    static float2 decode(Texel t)
+    {
+        return float2(t) * (1.f / 65535.f);
+    }
+};
+
+// 2^(e - 24) which turns a 9 bit mantissa of exponent e into its value
+inline const std::array<float, 32> RGB9E5ScaleTable = [] {
+    std::array<float, 32> t{};
+    for (int e = 0; e < 32; e++)
+        t[e] = std::ldexp(1.f, e - 24);
+    return t;
+}();
+
+// linear hdr color of environment maps as three 9 bit mantissas sharing a 5 bit exponent, 4 bytes instead of
+// 12 of float3, every channel keeps about 1 / 512 of the largest one and values are clamped to [0, MaxValue]
+struct RGB9E5
+{
+    using Texel = uint32_t;
+    static constexpr float MaxValue = 65408.f; // 511 / 512 * 2^16
+
+    static Texel encode(const float3 &c)
+    {
+        // nan is stored as zero
+        auto saturate = [](float v) { return v > 0.f ? std::min(v, MaxValue) : 0.f; };
+        const float r = saturate(c.r), g = saturate(c.g), b = saturate(c.b);
+        int e;
+        std::frexp(std::max({r, g, b}), &e);
+        // largest channel gets a mantissa in [256, 512) unless it is too small for the lowest exponent
+        int exponent = std::max(0, e + 15);
+        float scale = std::ldexp(1.f, 24 - exponent);
+        if (static_cast<uint32_t>(std::max({r, g, b}) * scale + 0.5f) == 512)
+        {
+            exponent++;
+            scale *= 0.5f;
+        }
+        auto mantissa = [&](float v) { return static_cast<uint32_t>(v * scale + 0.5f); };
+        return mantissa(r) | mantissa(g) << 9 | mantissa(b) << 18 | static_cast<uint32_t>(exponent) << 27;
+    }
+
+    static float3 decode(Texel t)
+    {
+        const float scale = RGB9E5ScaleTable[t >> 27];
+        return float3(static_cast<float>(t & 511u), static_cast<float>(t >> 9 & 511u),
+                      static_cast<float>(t >> 18 & 511u)) *
+               scale;
+    }
+
+    static Texel average(const Texel *t, int count)
+    {
+        float3 sum{0.f};
+        for (int i = 0; i < count; i++)
+            sum += decode(t[i]);
+        return encode(sum / static_cast<float>(count));
+    }
+};
+
+// texels are stored in TileSize x TileSize tiles so the 2x2 footprint of a bilinear fetch
+// is mostly inside one tile, which is one cache line for 4 byte texels
+template <typename Format>
+class PackedTexture
+{
+  public:
+    using Texel = typename Format::Texel;
+
+    static constexpr int TileShift = 2;
+    static constexpr int TileSize = 1 << TileShift;
+
+    PackedTexture() : w(0), h(0), tile_num_x(0)
+    {
+    }
+
+    PackedTexture(int w, int h)
+        : w(w), h(h), tile_num_x((w + TileSize - 1) / TileSize),
+          texels(static_cast<size_t>(tile_num_x) * ((h + TileSize - 1) / TileSize) * TileSize * TileSize)
+    {
+    }
+
+    // pixels are row major with Format::Channels bytes per pixel
+    PackedTexture(int w, int h, const uint8_t *pixels)
+        : w(w), h(h), tile_num_x((w + TileSize - 1) / TileSize)
+    {
+        const int tile_num_y = (h + TileSize - 1) / TileSize;
+        texels.resize(static_cast<size_t>(tile_num_x) * tile_num_y * TileSize * TileSize);
+        for (int y = 0; y < h; y++)
+        {
+            for (int x = 0; x < w; x++)
+            {
+                texels[toTiledIndex(x, y)] = Format::encode(pixels + (static_cast<size_t>(y) * w + x) * Format::Channels);
+            }
+        }
+    }
+
+    // decoded texel
+    auto operator()(int x, int y) const
+    {
+        return Format::decode(texels[toTiledIndex(x, y)]);
+    }
+
+    const Texel &texel(int x, int y) const
+    {
+        return texels[toTiledIndex(x, y)];
+    }
+
+    Texel &texel(int x, int y)
+    {
+        return texels[toTiledIndex(x, y)];
+    }
+
+    int width() const
+    {
+        return w;
+    }
+
+    int height() const
+    {
+        return h;
+    }
+
+    bool isAvailable() const
+    {
+        return !texels.empty();
+    }
+
+    size_t byteSize() const
+    {
+        return texels.size() * sizeof(Texel);
+    }
+
+    // texels in tiled order, byteSize() bytes
+    const Texel *data() const
+    {
+        return texels.data();
+    }
+
+    Texel *data()
+    {
+        return texels.data();
+    }
+
+  private:
+    int toTiledIndex(int x, int y) const
+    {
+        constexpr int mask = TileSize - 1;
+        return (((y >> TileShift) * tile_num_x + (x >> TileShift)) << (2 * TileShift)) + ((y & mask) << TileShift) +
+               (x & mask);
+    }
+
+    int w, h;
+    int tile_num_x;
+    std::vector<Texel> texels;
+};
+
+// the same footprint as DownsampleImage of Image2D, filtered by Format::average in parallel rows
+template <typename Format>
+PackedTexture<Format> DownsampleImage(const PackedTexture<Format> &src, int w, int h)
+{
+    PackedTexture<Format> dst(w, h);
+    parallel_for(0, h, [&](int y) {
+        typename Format::Texel footprint[9];
+        const int y0 = y * src.height() / h;
+        const int y1 = std::max(y0 + 1, (y + 1) * src.height() / h);
+        for (int x = 0; x < w; ++x)
+        {
+            const int x0 = x * src.width() / w;
+            const int x1 = std::max(x0 + 1, (x + 1) * src.width() / w);
+            int count = 0;
+            for (int sy = y0; sy < y1; ++sy)
+                for (int sx = x0; sx < x1; ++sx)
+                    footprint[count++] = src.texel(sx, sy);
+            dst.texel(x, y) = Format::average(footprint, count);
+        }
+    });
+    return dst;
+}
+
+// material textures keep a whole mip chain of packed levels
+template <typename Format>
+using PackedMipMap = MipMap2D<typename Format::Texel, PackedTexture<Format>>;
+
+using TextureR8    = PackedMipMap<R8>;
+using TextureRGBA8 = PackedMipMap<RGBA8_SRGB>;
+using TextureRG8   = PackedMipMap<RG8_Normal>;
+using TextureRG16  = PackedTexture<RG16>;
+
+// environment, irradiance and prefilter maps
+using TextureRGB9E5 = PackedMipMap<RGB9E5>;
+
 struct LinearSampler
 {
     template <typename T>
     static auto sample2D(const Image<T> &tex, float u, float v)
+    {
+        return bilinear(tex, u, v);
+    }
+
+    template <typename Format>
+    static auto sample2D(const PackedTexture<Format> &tex, float u, float v)
+    {
+        return bilinear(tex, u, v);
+    }
+
+    template<typename Texel, typename Level>
+    static auto sample2D(const MipMap2D<Texel, Level>& mipmap,float u,float v,float level){
+        assert(mipmap.valid());
+        int max_level = mipmap.levels() - 1;
+        // NaN level of a degenerate quad would pass clamp and make the level index undefined
+        level = std::isfinite(level) ? std::clamp<float>(level,0,max_level) : 0.f;
+        int l0 = std::floor(level);
+        int l1 = l0 + 1;
+        float w0 = l1 - level;
+        float w1 = level - l0;
+        // magnified or the last level only needs one fetch
+        if(w1 == 0.f || l1 > max_level){
+            return sample2D(mipmap.get_level(l0),u,v);
+        }
+        auto v0 = sample2D(mipmap.get_level(l0),u,v);
+        auto v1 = sample2D(mipmap.get_level(l1),u,v);
+        return v0 * w0 + v1 * w1;
+    }
+
+    // level of detail for the screen space uv derivatives of a fragment, the larger axis of footprint is used
+    template<typename Texel, typename Level>
+    static float mipLevel(const MipMap2D<Texel, Level>& mipmap,float du_dx,float dv_dx,float du_dy,float dv_dy){
+        const float w = static_cast<float>(mipmap.width());
+        const float h = static_cast<float>(mipmap.height());
+        const float dx = du_dx * du_dx * w * w + dv_dx * dv_dx * h * h;
+        const float dy = du_dy * du_dy * w * w + dv_dy * dv_dy * h * h;
+        // derivatives of collinear or zero area helper lanes are not finite
+        if(!std::isfinite(dx) || !std::isfinite(dy))
+            return 0.f;
+        return 0.5f * std::log2(std::max(dx, dy));
+    }
+
+  private:
+    template <typename Tex>
+    static auto bilinear(const Tex &tex, float u, float v)
     {
         u = std::clamp(u, 0.0f, 1.0f) * (tex.width() - 1);
         v = std::clamp(v, 0.0f, 1.0f) * (tex.height() - 1);
@@ -25,19 +369,23 @@ struct LinearSampler
         return (tex(u0, v0) * (1.0f - d_u) + tex(u1, v0) * d_u) * (1.0f - d_v) +
                (tex(u0, v1) * (1.0f - d_u) + tex(u1, v1) * d_u) * d_v;
     }
+};
 
-    template<typename Texel>
-    static auto sample2D(const MipMap2D<Texel>& mipmap,float u,float v,float level){
-        assert(mipmap.valid());
-        int max_level = mipmap.levels() - 1;
-        level = std::clamp<float>(level,0,max_level);
-        int l0 = std::floor(level);
-        int l1 = l0 + 1;
-        float w0 = l1 - level;
-        float w1 = level - l0;
-        l1 = std::clamp(l1,0,max_level);
-        auto v0 = sample2D(mipmap.get_level(l0),u,v);
-        auto v1 = sample2D(mipmap.get_level(l1),u,v);
-        return v0 * w0 + v1 * w1;
+// environment maps (sky, irradiance and prefilter) are in octahedral layout, see octahedralTexelDirection,
+// they are looked up by direction which need not be normalized
+struct OctahedralSampler
+{
+    template <typename Tex>
+    static auto sample(const Tex &map, const float3 &dir)
+    {
+        const float2 uv = octahedralEncode(dir);
+        return LinearSampler::sample2D(map, uv.x, uv.y);
+    }
+
+    template <typename Texel, typename Level>
+    static auto sample(const MipMap2D<Texel, Level> &map, const float3 &dir, float level)
+    {
+        const float2 uv = octahedralEncode(dir);
+        return LinearSampler::sample2D(map, uv.x, uv.y, level);
     }
-};
\ No newline at end of file
+};
@@ -0,0 +1,97 @@
+#include "vertex_transform.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#define VERTEX_USE_SSE
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+void TransformVertex(const Mesh &mesh, int i, const mat4 &clip_matrix, const mat4 &model_matrix,
+                     Triangle::Vertex &out)
+{
+    const float4 pos{mesh.position(i), 1.f};
+    const float4 normal{mesh.stream(Mesh::NormalX)[i], mesh.stream(Mesh::NormalY)[i], mesh.stream(Mesh::NormalZ)[i],
+                        0.f};
+    out.gl_Position = clip_matrix * pos;
+    out.pos = model_matrix * pos;
+    out.normal = model_matrix * normal;
+    out.tex_coord = {mesh.stream(Mesh::TexCoordU)[i], mesh.stream(Mesh::TexCoordV)[i]};
+}
+
+#ifdef VERTEX_USE_SSE
+// broadcast matrix elements once per call, row r of the result is m[0][r] * x + m[1][r] * y + m[2][r] * z + m[3][r]
+struct SplatMatrix
+{
+    __m128 m[4][4];
+
+    explicit SplatMatrix(const mat4 &matrix)
+    {
+        for (int c = 0; c < 4; c++)
+            for (int r = 0; r < 4; r++)
+                m[c][r] = _mm_set1_ps(matrix[c][r]);
+    }
+
+    __m128 point(int r, __m128 x, __m128 y, __m128 z) const
+    {
+        return _mm_add_ps(_mm_add_ps(_mm_mul_ps(m[0][r], x), _mm_mul_ps(m[1][r], y)),
+                          _mm_add_ps(_mm_mul_ps(m[2][r], z), m[3][r]));
+    }
+
+    __m128 direction(int r, __m128 x, __m128 y, __m128 z) const
+    {
+        return _mm_add_ps(_mm_add_ps(_mm_mul_ps(m[0][r], x), _mm_mul_ps(m[1][r], y)), _mm_mul_ps(m[2][r], z));
+    }
+};
+#endif
+} // namespace
+
+void TransformVertices(const Mesh &mesh, int beg, int end, const mat4 &clip_matrix, const mat4 &model_matrix,
+                       Triangle::Vertex *out)
+{
+    int i = beg;
+#ifdef VERTEX_USE_SSE
+    const SplatMatrix clip(clip_matrix);
+    const SplatMatrix model(model_matrix);
+    const float *px = mesh.stream(Mesh::PositionX);
+    const float *py = mesh.stream(Mesh::PositionY);
+    const float *pz = mesh.stream(Mesh::PositionZ);
+    const float *nx = mesh.stream(Mesh::NormalX);
+    const float *ny = mesh.stream(Mesh::NormalY);
+    const float *nz = mesh.stream(Mesh::NormalZ);
+    const float *tu = mesh.stream(Mesh::TexCoordU);
+    const float *tv = mesh.stream(Mesh::TexCoordV);
+    // 4 vertices are transformed per iteration then scattered into Triangle::Vertex which assembly gathers by index
+    for (; i + 4 <= end; i += 4)
+    {
+        const __m128 x = _mm_loadu_ps(px + i);
+        const __m128 y = _mm_loadu_ps(py + i);
+        const __m128 z = _mm_loadu_ps(pz + i);
+        const __m128 n_x = _mm_loadu_ps(nx + i);
+        const __m128 n_y = _mm_loadu_ps(ny + i);
+        const __m128 n_z = _mm_loadu_ps(nz + i);
+
+        alignas(16) float result[10][4];
+        for (int r = 0; r < 4; r++)
+            _mm_store_ps(result[r], clip.point(r, x, y, z));
+        for (int r = 0; r < 3; r++)
+        {
+            _mm_store_ps(result[4 + r], model.point(r, x, y, z));
+            _mm_store_ps(result[7 + r], model.direction(r, n_x, n_y, n_z));
+        }
+
+        for (int k = 0; k < 4; k++)
+        {
+            auto &v = out[i + k - beg];
+            v.gl_Position = {result[0][k], result[1][k], result[2][k], result[3][k]};
+            v.pos = {result[4][k], result[5][k], result[6][k]};
+            v.normal = {result[7][k], result[8][k], result[9][k]};
+            v.tex_coord = {tu[i + k], tv[i + k]};
+        }
+    }
+#endif
+    for (; i < end; i++)
+    {
+        TransformVertex(mesh, i, clip_matrix, model_matrix, out[i - beg]);
+    }
+}
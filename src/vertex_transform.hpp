@@ -0,0 +1,11 @@
+#pragma once
+
+#include "mesh.hpp"
+
+/**
+ * @brief transform mesh vertices [beg,end) into out[0,end - beg).
+ * gl_Position = clip_matrix * pos, pos = model_matrix * pos and normal = model_matrix * normal without translation,
+ * so every matrix a draw needs should be multiplied once before instead of per vertex.
+ */
+void TransformVertices(const Mesh &mesh, int beg, int end, const mat4 &clip_matrix, const mat4 &model_matrix,
+                       Triangle::Vertex *out);
@@ -22,7 +22,7 @@ void NaiveZBuffer::updateZBuffer(int x, int y, float zVal)
 void NaiveZBuffer::clear()
 {
     int width = z_buffer.width(),height = z_buffer.height();
-    parallel_forrange(0,height,[&](int,int h){
+    parallel_for(0,height,[&](int h){
         for(int w = 0; w < width; ++w){
             z_buffer(w,h) = std::numeric_limits<float>::max();
         }
@@ -16,6 +16,9 @@ class ZBuffer
 
     virtual void updateZBuffer(int x, int y, float zVal) = 0;
 
+    // make box test see depth written inside [xMin,xMax]x[yMin,yMax] since last call
+    virtual void updateHierarchy(int xMin, int yMin, int xMax, int yMax) {}
+
     virtual void clear() = 0;
 
 };
@@ -37,7 +40,9 @@ class NaiveZBuffer : public ZBuffer
 class HierarchicalZBuffer : public ZBuffer
 {
   public:
-    HierarchicalZBuffer(int w, int h);
+    // coarsest level has cells of maxCellSize x maxCellSize pixels which should be a power of 2,
+    // cells of it are never shared by regions aligned to maxCellSize
+    HierarchicalZBuffer(int w, int h, int maxCellSize);
 
     bool zTest(const BoundBox2D &box, float minZVal) const override;
 
@@ -45,6 +50,8 @@ class HierarchicalZBuffer : public ZBuffer
 
     void updateZBuffer(int x, int y, float zVal) override;
 
+    void updateHierarchy(int xMin, int yMin, int xMax, int yMax) override;
+
     void clear() override;
 
     ~HierarchicalZBuffer() override;
@@ -0,0 +1,59 @@
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "model.hpp"
+#include "parallel.hpp"
+
+// integrate brdf lut at IBL::BRDFLUTSize and write it as the c++ source embedded by the renderer:
+// BRDFLUTGenerator ../src/brdf_lut_data.cpp
+int main(int argc, char **argv)
+{
+    if (argc != 2)
+    {
+        std::cerr << "params format: output.cpp" << std::endl;
+        return 1;
+    }
+
+    constexpr int Size = IBL::BRDFLUTSize;
+    static_assert(Size % 8 == 0, "rows are written 8 texels per line");
+    std::vector<RG16::Texel> texels(Size * Size);
+    // texels are at the corners of their cells so bilinear lookup of lut returns them exactly
+    parallel_for(0, Size, [&](int h) {
+        for (int w = 0; w < Size; ++w)
+        {
+            const float NdotV = static_cast<float>(w) / (Size - 1);
+            const float roughness = static_cast<float>(h) / (Size - 1);
+            texels[h * Size + w] = RG16::encode(integrateBRDF(NdotV, roughness));
+        }
+    });
+
+    std::ofstream out(argv[1]);
+    if (!out.is_open())
+    {
+        std::cerr << "open output file failed: " << argv[1] << std::endl;
+        return 1;
+    }
+    out << "// generated by BRDFLUTGenerator, do not edit\n"
+           "// "
+        << Size << "x" << Size << " brdf lut of " << IBL::BRDFSampleCount
+        << " samples per texel, rows of roughness with (scale, bias) of F0 as 16 bit unorm\n"
+           "#include <cstdint>\n\n"
+           "#include \"model.hpp\"\n\n"
+           "extern const uint16_t BRDFLUTData[IBL::BRDFLUTSize * IBL::BRDFLUTSize * 2] = {\n";
+    for (int h = 0; h < Size; ++h)
+    {
+        for (int w = 0; w < Size; w += 8)
+        {
+            out << "   ";
+            for (int i = w; i < w + 8; ++i)
+            {
+                const auto &t = texels[h * Size + i];
+                out << " " << t.x << "," << t.y << ",";
+            }
+            out << "\n";
+        }
+    }
+    out << "};\n";
+    return out.good() ? 0 : 1;
+}